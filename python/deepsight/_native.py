@@ -0,0 +1,30 @@
+"""Loading of deepsight.dll for the modules that call its C exports through ctypes.
+
+tiff2vdb and infolog use the same extern "C" functions as DeepSightNet rather than
+the pybind11 module _deepsight that __init__.py imports. _deepsight is built
+outside this repository and does not bind the TIFF conversion or InfoLog
+functions, while deepsight.dll ships next to it in the wheel. Calling the DLL
+directly makes the new functions usable without rebuilding _deepsight, and lets
+infolog hand out NumPy views of native memory without copying it.
+"""
+
+import ctypes
+import os
+
+_lib = None
+
+
+def load_library():
+    global _lib
+    if _lib is not None:
+        return _lib
+
+    module_dir = os.path.dirname(os.path.abspath(__file__))
+
+    # The dependencies of deepsight.dll are shipped next to it
+    if hasattr(os, "add_dll_directory"):
+        os.add_dll_directory(module_dir)
+
+    path = os.path.join(module_dir, "deepsight.dll")
+    _lib = ctypes.CDLL(path if os.path.exists(path) else "deepsight.dll")
+    return _lib
@@ -0,0 +1,106 @@
+"""Read InfoLog pith, knots and outlines as NumPy arrays without copying them.
+
+The arrays are views of the InfoLog held by deepsight.dll and stay valid while
+the InfoLog object is alive. The functions are called through ctypes on the C
+exports of deepsight.dll, not through _deepsight (see _native).
+
+    log = InfoLog("C:/scans/log01_info.tif")
+    pith = log.pith                    # (n, 2) float32
+    outline = log.border_outline(10)   # (m, 2) float32
+"""
+
+import ctypes
+
+import numpy as np
+
+from ._native import load_library
+
+KNOT_DTYPE = np.dtype([
+    ("radius", np.float32), ("length", np.float32), ("volume", np.float32),
+    ("index", np.int32), ("dead_knot_border", np.int32),
+    ("start", np.float32, 3), ("end", np.float32, 3)])
+
+_lib = None
+
+
+def _library():
+    global _lib
+    if _lib is not None:
+        return _lib
+
+    lib = load_library()
+
+    lib.InfoLog_Open.argtypes = [ctypes.c_char_p]
+    lib.InfoLog_Open.restype = ctypes.c_void_p
+    lib.InfoLog_Delete.argtypes = [ctypes.c_void_p]
+    lib.InfoLog_Delete.restype = None
+
+    # Reference arguments are passed as pointers
+    lib.InfoLog_GetPith.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_void_p)]
+    lib.InfoLog_GetKnots.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_void_p)]
+    for name in ("InfoLog_GetBorder", "InfoLog_GetSapwood"):
+        getattr(lib, name).argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_void_p),
+            ctypes.POINTER(ctypes.c_longlong), ctypes.POINTER(ctypes.c_void_p)]
+
+    _lib = lib
+    return lib
+
+
+def _view(address, dtype, count):
+    if count == 0 or not address:
+        return np.empty(0, dtype=dtype)
+
+    buffer = (ctypes.c_char * (count * np.dtype(dtype).itemsize)).from_address(address)
+    array = np.frombuffer(buffer, dtype=dtype, count=count)
+    array.flags.writeable = False
+    return array
+
+
+class InfoLog:
+    def __init__(self, path):
+        self._lib = _library()
+        self._ptr = self._lib.InfoLog_Open(path.encode())
+        if not self._ptr:
+            raise IOError("Failed to load InfoLog '{}'".format(path))
+
+        n, data = ctypes.c_int(), ctypes.c_void_p()
+        self._lib.InfoLog_GetPith(self._ptr, ctypes.byref(n), ctypes.byref(data))
+        self.pith = _view(data.value, np.float32, n.value * 2).reshape(-1, 2)
+
+        self._lib.InfoLog_GetKnots(self._ptr, ctypes.byref(n), ctypes.byref(data))
+        self.knots = _view(data.value, KNOT_DTYPE, n.value)
+
+        self.border_offsets, self.border_points = self._outlines(self._lib.InfoLog_GetBorder)
+        self.sapwood_offsets, self.sapwood_points = self._outlines(self._lib.InfoLog_GetSapwood)
+
+    def _outlines(self, getter):
+        n, offsets, n_points, points = ctypes.c_int(), ctypes.c_void_p(), ctypes.c_longlong(), ctypes.c_void_p()
+        getter(self._ptr, ctypes.byref(n), ctypes.byref(offsets), ctypes.byref(n_points), ctypes.byref(points))
+
+        return (_view(offsets.value, np.uint64, n.value + 1),
+                _view(points.value, np.float32, n_points.value * 2).reshape(-1, 2))
+
+    def border_outline(self, i):
+        return self.border_points[self.border_offsets[i]:self.border_offsets[i + 1]]
+
+    def sapwood_outline(self, i):
+        return self.sapwood_points[self.sapwood_offsets[i]:self.sapwood_offsets[i + 1]]
+
+    def close(self):
+        # The arrays point into the native InfoLog, so they go with it
+        if getattr(self, "_ptr", None):
+            self.pith = self.knots = None
+            self.border_offsets = self.border_points = None
+            self.sapwood_offsets = self.sapwood_points = None
+            self._lib.InfoLog_Delete(self._ptr)
+            self._ptr = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
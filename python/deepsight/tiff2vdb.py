@@ -0,0 +1,100 @@
+"""Convert TIFF stacks into .vdb files, one band of pages at a time.
+
+Every input is a multi-page TIFF or a folder of single-slice TIFF files, and
+patterns such as "C:/scans/*.tif" are expanded into several inputs. Only one
+band of pages is held in memory, and every band is written to its own file:
+-o D:/vdb/log01.vdb writes D:/vdb/log01_0000.vdb, D:/vdb/log01_0001.vdb, ...
+and no log01.vdb itself. All bands share the same index space and transform,
+so they can be loaded side by side, or merged into one grid again with
+GridIO.ReadVdbBands (ReadWrite_ReadVdbBands) given the same output path.
+
+The conversion is done by the C export ReadWrite_ConvertTiff of deepsight.dll,
+called through ctypes like infolog (see _native for why not _deepsight).
+
+    python -m deepsight.tiff2vdb C:/scans/log01.tif -o D:/vdb/log01.vdb --band-pages 256
+    python -m deepsight.tiff2vdb C:/scans/*.tif --otsu --reduction 2
+"""
+
+import argparse
+import ctypes
+import glob
+import os
+import sys
+
+from . import _native
+
+THRESHOLD_FIXED = 0
+THRESHOLD_OTSU = 1
+THRESHOLD_PERCENTILE = 2
+
+
+def load_library():
+    lib = _native.load_library()
+
+    lib.ReadWrite_ConvertTiff.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p, ctypes.c_double,
+        ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+    lib.ReadWrite_ConvertTiff.restype = ctypes.c_int
+
+    return lib
+
+
+def expand_inputs(inputs):
+    # Files matching a pattern are converted one by one, folders are sequences of slices
+    paths = []
+    for item in inputs:
+        matches = sorted(glob.glob(item)) if not os.path.isdir(item) else [item]
+        paths.extend(matches if matches else [item])
+    return paths
+
+
+def output_path(input_path, output, num_inputs):
+    name = os.path.splitext(os.path.basename(os.path.normpath(input_path)))[0] + ".vdb"
+
+    if output is None:
+        return os.path.join(os.path.dirname(os.path.abspath(input_path)), name)
+    if num_inputs > 1 or os.path.isdir(output):
+        return os.path.join(output, name)
+    return output
+
+
+def main(argv=None):
+    # The whole docstring is shown, as it describes the band files that are written
+    parser = argparse.ArgumentParser(prog="python -m deepsight.tiff2vdb", description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", help="Multi-page TIFF files, folders of slices or patterns")
+    parser.add_argument("-o", "--output", help="Output .vdb path, or folder if there are several inputs. "
+                        "Bands are written next to it as <name>_0000.vdb, <name>_0001.vdb, ...")
+    parser.add_argument("--threshold", type=float, default=1.0e-3, help="Values below are left out (default 1e-3)")
+    parser.add_argument("--otsu", action="store_true", help="Choose the threshold with Otsu's method")
+    parser.add_argument("--percentile", type=float, help="Choose the threshold as a percentile (0 - 1) of the values")
+    parser.add_argument("--reduction", type=int, default=1, help="Integer downsampling factor (default 1)")
+    parser.add_argument("--band-pages", type=int, default=256, help="Pages per band file (default 256)")
+    parser.add_argument("--half", action="store_true", help="Save values as 16-bit floats")
+    args = parser.parse_args(argv)
+
+    mode, threshold = THRESHOLD_FIXED, args.threshold
+    if args.otsu:
+        mode = THRESHOLD_OTSU
+    elif args.percentile is not None:
+        mode, threshold = THRESHOLD_PERCENTILE, args.percentile
+
+    lib = load_library()
+    inputs = expand_inputs(args.inputs)
+    failed = 0
+
+    for path in inputs:
+        out = output_path(path, args.output, len(inputs))
+        print("{} -> {}".format(path, out), flush=True)
+
+        num_bands = lib.ReadWrite_ConvertTiff(path.encode(), out.encode(), threshold, mode,
+                                              args.reduction, args.band_pages, int(args.half))
+        if num_bands < 0:
+            print("Failed to convert {}".format(path), file=sys.stderr)
+            failed += 1
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
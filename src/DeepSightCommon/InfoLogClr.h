@@ -58,22 +58,24 @@ namespace DeepSightCommon
 			m_borders = gcnew array<array<System::Tuple<float, float>^>^>(m_infolog->border.size());
 			for (size_t i = 0; i < m_infolog->border.size(); ++i)
 			{
-				m_borders[i] = gcnew array<System::Tuple<float, float>^>(m_infolog->border[i].size());
+				const Eigen::Vector2f* outline = m_infolog->border.outline(i);
+				m_borders[i] = gcnew array<System::Tuple<float, float>^>(m_infolog->border.outline_size(i));
 
-				for (size_t j = 0; j < m_infolog->border[i].size(); ++j)
+				for (size_t j = 0; j < m_infolog->border.outline_size(i); ++j)
 				{
-					m_borders[i][j] = gcnew System::Tuple<float, float>(m_infolog->border[i][j].x(), m_infolog->border[i][j].y());
+					m_borders[i][j] = gcnew System::Tuple<float, float>(outline[j].x(), outline[j].y());
 				}
 			}
 
 			m_sapwood = gcnew array<array<System::Tuple<float, float>^>^>(m_infolog->sapwood.size());
 			for (size_t i = 0; i < m_infolog->sapwood.size(); ++i)
 			{
-				m_sapwood[i] = gcnew array<System::Tuple<float, float>^>(m_infolog->sapwood[i].size());
+				const Eigen::Vector2f* outline = m_infolog->sapwood.outline(i);
+				m_sapwood[i] = gcnew array<System::Tuple<float, float>^>(m_infolog->sapwood.outline_size(i));
 
-				for (size_t j = 0; j < m_infolog->sapwood[i].size(); ++j)
+				for (size_t j = 0; j < m_infolog->sapwood.outline_size(i); ++j)
 				{
-					m_sapwood[i][j] = gcnew System::Tuple<float, float>(m_infolog->sapwood[i][j].x(), m_infolog->sapwood[i][j].y());
+					m_sapwood[i][j] = gcnew System::Tuple<float, float>(outline[j].x(), outline[j].y());
 				}
 			}
 		}
@@ -47,6 +47,12 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void Vec3fGrid_combine(IntPtr ptr0, IntPtr ptr1, int type);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void QuantizedGrid_combine(IntPtr ptr0, IntPtr ptr1, int type);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void Scalar_QuantizedGrid_combine(IntPtr ptr0, float n, int type);
+
         #endregion
 
         public static FloatGrid Combine(FloatGrid grid0, FloatGrid grid1, CombineType type)
@@ -77,6 +83,30 @@ namespace DeepSight
             return ngrid0;
         }
 
+        /// <summary>
+        /// Combine a quantized grid with a quantized grid or a FloatGrid. The result keeps
+        /// the type and quantization of grid0.
+        /// </summary>
+        public static QuantizedGrid Combine(QuantizedGrid grid0, GridBase<float> grid1, CombineType type)
+        {
+            var ngrid0 = grid0.Duplicate() as QuantizedGrid;
+            var ngrid1 = grid1.Duplicate();
+
+            QuantizedGrid_combine(ngrid0.Ptr, ngrid1.Ptr, (int)type);
+            ngrid1.Dispose();
+
+            return ngrid0;
+        }
+
+        public static QuantizedGrid Combine(QuantizedGrid grid0, float n, ScalarCombineType type)
+        {
+            var ngrid0 = grid0.Duplicate() as QuantizedGrid;
+
+            Scalar_QuantizedGrid_combine(ngrid0.Ptr, n, (int)type);
+
+            return ngrid0;
+        }
+
         private static GridApi Sum(GridApi grid0, GridApi grid1)
         {
             return grid0;
@@ -7,6 +7,16 @@ using System.Runtime.InteropServices;
 
 namespace DeepSight
 {
+    /// <summary>
+    /// Voxel labels of Convert.OutlinesToLabels. Mirrors DeepSight::OutlineLabel.
+    /// </summary>
+    public enum OutlineLabel
+    {
+        Outside = 0,
+        Sapwood = 1,
+        Heartwood = 2
+    }
+
     public static class Convert
     {
         #region Api calls
@@ -19,6 +29,12 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern IntPtr FloatGrid_FromPoints(int num_points, float[] point_data, float radius, float voxel_size);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr FloatGrid_FromKnots(IntPtr infolog, IntPtr reference, float half_width, out IntPtr index_grid);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr Int32Grid_FromOutlines(IntPtr infolog, IntPtr reference, double z_origin, double z_spacing);
+
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern IntPtr DoubleGrid_ToMesh(IntPtr ptr, float isovalue);
 
@@ -52,6 +68,29 @@ namespace DeepSight
             return new FloatGrid(FloatGrid_FromPoints(points.Length/3, points, radius, voxelsize));
         }
 
+        /// <summary>
+        /// Level set of the knots of an InfoLog, taken as capsules around the segments from their start to their end,
+        /// with the transform of the reference grid. The band reaches half_width voxels to both sides of the knot surfaces.
+        /// index_grid receives the position of the nearest knot in the InfoLog for every voxel of the band.
+        /// </summary>
+        public static FloatGrid KnotsToVolume(InfoLogView infolog, GridApi reference, out Int32Grid index_grid, float half_width = 3.0f)
+        {
+            IntPtr ptr = FloatGrid_FromKnots(infolog.Ptr, reference.Ptr, half_width, out IntPtr index_ptr);
+
+            index_grid = index_ptr == IntPtr.Zero ? null : new Int32Grid(index_ptr);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
+        /// <summary>
+        /// Fill the border and sapwood outlines of an InfoLog into a grid of OutlineLabel values, with the transform of
+        /// the reference grid. Outline i lies at world z = z_origin + i * z_spacing. Outside voxels are inactive.
+        /// </summary>
+        public static Int32Grid OutlinesToLabels(InfoLogView infolog, GridApi reference, double z_origin = 0.0, double z_spacing = 1.0)
+        {
+            IntPtr ptr = Int32Grid_FromOutlines(infolog.Ptr, reference.Ptr, z_origin, z_spacing);
+            return ptr == IntPtr.Zero ? null : new Int32Grid(ptr);
+        }
+
         public static void SdfToFog(FloatGrid grid, float cutoffDistance)
         {
             FloatGrid_SdfToFog(grid.Ptr, cutoffDistance);
@@ -78,6 +78,56 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern void Vec3fGrid_Dilate(IntPtr ptr, int iterations);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr UInt8Grid_Resample(IntPtr ptr, float scale);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr UInt16Grid_Resample(IntPtr ptr, float scale);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr HalfGrid_Resample(IntPtr ptr, float scale);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr FloatGrid_StraightenPith(IntPtr ptr, IntPtr infolog, double z_origin, double z_spacing, int rotate);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr DoubleGrid_StraightenPith(IntPtr ptr, IntPtr infolog, double z_origin, double z_spacing, int rotate);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void FloatGrid_PolarUnwrap(IntPtr ptr, IntPtr infolog, double z_origin, double z_spacing,
+            int k_begin, int k_end, int num_radii, int num_angles, double radial_step, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void DoubleGrid_PolarUnwrap(IntPtr ptr, IntPtr infolog, double z_origin, double z_spacing,
+            int k_begin, int k_end, int num_radii, int num_angles, double radial_step, double[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void UInt8Grid_Filter(IntPtr ptr, int width, int iterations, int type);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void UInt16Grid_Filter(IntPtr ptr, int width, int iterations, int type);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void HalfGrid_Filter(IntPtr ptr, int width, int iterations, int type);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void UInt8Grid_Erode(IntPtr ptr, int iterations);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void UInt16Grid_Erode(IntPtr ptr, int iterations);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void HalfGrid_Erode(IntPtr ptr, int iterations);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void UInt8Grid_Dilate(IntPtr ptr, int iterations);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void UInt16Grid_Dilate(IntPtr ptr, int iterations);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void HalfGrid_Dilate(IntPtr ptr, int iterations);
+
         #endregion
 
         public static FloatGrid Resample(FloatGrid grid, double scale)
@@ -95,6 +145,42 @@ namespace DeepSight
             return new Int32Grid(Int32Grid_Resample(grid.Ptr, (float)scale));
         }
 
+        /// <summary>
+        /// Resample a grid so that the pith of the log becomes the z axis (x = y = 0). Pith point i lies at
+        /// world z = z_origin + i * z_spacing. With rotate, slices are cut at right angles to the pith and
+        /// the output z is measured along it.
+        /// </summary>
+        public static FloatGrid StraightenPith(FloatGrid grid, InfoLogView infolog, double z_origin = 0.0, double z_spacing = 1.0, bool rotate = false)
+        {
+            return new FloatGrid(FloatGrid_StraightenPith(grid.Ptr, infolog.Ptr, z_origin, z_spacing, rotate ? 1 : 0));
+        }
+
+        public static DoubleGrid StraightenPith(DoubleGrid grid, InfoLogView infolog, double z_origin = 0.0, double z_spacing = 1.0, bool rotate = false)
+        {
+            return new DoubleGrid(DoubleGrid_StraightenPith(grid.Ptr, infolog.Ptr, z_origin, z_spacing, rotate ? 1 : 0));
+        }
+
+        /// <summary>
+        /// Sample index z slices [k_begin, k_end) on polar rasters centred on the pith. Slice k holds num_angles rows
+        /// of num_radii values, value ((k - k_begin) * num_angles + a) * num_radii + r lying at radius r * radial_step
+        /// and angle 2 pi a / num_angles from the x axis. Pith point i lies at world z = z_origin + i * z_spacing.
+        /// </summary>
+        public static float[] PolarUnwrap(FloatGrid grid, InfoLogView infolog, int k_begin, int k_end, int num_radii, int num_angles,
+            double radial_step, double z_origin = 0.0, double z_spacing = 1.0)
+        {
+            var values = new float[Math.Max(0, k_end - k_begin) * num_radii * num_angles];
+            FloatGrid_PolarUnwrap(grid.Ptr, infolog.Ptr, z_origin, z_spacing, k_begin, k_end, num_radii, num_angles, radial_step, values);
+            return values;
+        }
+
+        public static double[] PolarUnwrap(DoubleGrid grid, InfoLogView infolog, int k_begin, int k_end, int num_radii, int num_angles,
+            double radial_step, double z_origin = 0.0, double z_spacing = 1.0)
+        {
+            var values = new double[Math.Max(0, k_end - k_begin) * num_radii * num_angles];
+            DoubleGrid_PolarUnwrap(grid.Ptr, infolog.Ptr, z_origin, z_spacing, k_begin, k_end, num_radii, num_angles, radial_step, values);
+            return values;
+        }
+
         public static void Filter(FloatGrid grid, int width, int iterations, FilterType type)
         {
             FloatGrid_Filter(grid.Ptr, width, iterations, (int)type);
@@ -150,6 +236,66 @@ namespace DeepSight
             Vec3fGrid_Dilate(grid.Ptr, iterations);
         }
 
+        public static UInt8Grid Resample(UInt8Grid grid, double scale)
+        {
+            return new UInt8Grid(UInt8Grid_Resample(grid.Ptr, (float)scale));
+        }
+
+        public static void Filter(UInt8Grid grid, int width, int iterations, FilterType type)
+        {
+            UInt8Grid_Filter(grid.Ptr, width, iterations, (int)type);
+        }
+
+        public static void Erode(UInt8Grid grid, int iterations)
+        {
+            UInt8Grid_Erode(grid.Ptr, iterations);
+        }
+
+        public static void Dilate(UInt8Grid grid, int iterations)
+        {
+            UInt8Grid_Dilate(grid.Ptr, iterations);
+        }
+
+        public static UInt16Grid Resample(UInt16Grid grid, double scale)
+        {
+            return new UInt16Grid(UInt16Grid_Resample(grid.Ptr, (float)scale));
+        }
+
+        public static void Filter(UInt16Grid grid, int width, int iterations, FilterType type)
+        {
+            UInt16Grid_Filter(grid.Ptr, width, iterations, (int)type);
+        }
+
+        public static void Erode(UInt16Grid grid, int iterations)
+        {
+            UInt16Grid_Erode(grid.Ptr, iterations);
+        }
+
+        public static void Dilate(UInt16Grid grid, int iterations)
+        {
+            UInt16Grid_Dilate(grid.Ptr, iterations);
+        }
+
+        public static HalfGrid Resample(HalfGrid grid, double scale)
+        {
+            return new HalfGrid(HalfGrid_Resample(grid.Ptr, (float)scale));
+        }
+
+        public static void Filter(HalfGrid grid, int width, int iterations, FilterType type)
+        {
+            HalfGrid_Filter(grid.Ptr, width, iterations, (int)type);
+        }
+
+        public static void Erode(HalfGrid grid, int iterations)
+        {
+            HalfGrid_Erode(grid.Ptr, iterations);
+        }
+
+        public static void Dilate(HalfGrid grid, int iterations)
+        {
+            HalfGrid_Dilate(grid.Ptr, iterations);
+        }
+
         private static void Gaussian(GridApi grid, int iterations, int width)
         {
 
@@ -7,6 +7,130 @@ using System.Runtime.InteropServices;
 
 namespace DeepSight
 {
+    /// <summary>
+    /// How the threshold of a TIFF load is chosen. Mirrors DeepSight::TiffReadSettings::ThresholdMode.
+    /// </summary>
+    public enum TiffThresholdMode
+    {
+        Fixed,
+        Otsu,
+        Percentile
+    }
+
+    /// <summary>
+    /// How appended TIFF pages are combined with the active voxels of a grid. Mirrors DeepSight::TiffBlendMode.
+    /// </summary>
+    public enum TiffBlendMode
+    {
+        Overwrite,
+        Max,
+        Average
+    }
+
+    /// <summary>
+    /// Sample type of an uncompressed volume. Mirrors DeepSight::RawVolumeInfo::SampleType.
+    /// </summary>
+    public enum RawSampleType
+    {
+        UInt8,
+        UInt16,
+        Float32
+    }
+
+    /// <summary>
+    /// Statistics of the values of a TIFF region, collected while it is loaded.
+    /// Mirrors DeepSight::TiffReadStats.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TiffReadStats
+    {
+        public const int NumBins = 256;
+
+        public double HistMin, HistMax;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = NumBins)]
+        public ulong[] Histogram;
+
+        public ulong TotalCount, ActiveCount;
+        public double Threshold;
+        public double Min, Max, Mean, Variance;
+        public double M2;
+
+        public static TiffReadStats Create(double hist_min = 0.0, double hist_max = 1.0)
+        {
+            return new TiffReadStats
+            {
+                HistMin = hist_min,
+                HistMax = hist_max,
+                Histogram = new ulong[NumBins]
+            };
+        }
+
+        /// <summary>
+        /// Value below which the fraction p (0 - 1) of all values falls.
+        /// </summary>
+        public double Percentile(double p)
+        {
+            if (TotalCount == 0 || Histogram == null)
+                return 0.0;
+
+            double target = Math.Min(Math.Max(p, 0.0), 1.0) * TotalCount;
+            double bin_width = (HistMax - HistMin) / NumBins;
+            double cumulative = 0.0;
+
+            for (int i = 0; i < NumBins; ++i)
+            {
+                if (Histogram[i] > 0 && cumulative + Histogram[i] >= target)
+                    return HistMin + bin_width * (i + (target - cumulative) / Histogram[i]);
+
+                cumulative += Histogram[i];
+            }
+
+            return HistMax;
+        }
+
+        /// <summary>
+        /// Value that best separates the histogram into two classes (Otsu's method).
+        /// </summary>
+        public double OtsuThreshold()
+        {
+            if (Histogram == null)
+                return HistMin;
+
+            double total = 0.0, total_sum = 0.0;
+            for (int i = 0; i < NumBins; ++i)
+            {
+                total += Histogram[i];
+                total_sum += (double)i * Histogram[i];
+            }
+
+            double weight = 0.0, sum = 0.0, best = -1.0;
+            int best_bin = 0;
+
+            for (int i = 0; i < NumBins - 1; ++i)
+            {
+                weight += Histogram[i];
+                sum += (double)i * Histogram[i];
+
+                double other_weight = total - weight;
+                if (weight == 0.0)
+                    continue;
+                if (other_weight == 0.0)
+                    break;
+
+                double delta = sum / weight - (total_sum - sum) / other_weight;
+                double between = weight * other_weight * delta * delta;
+
+                if (between > best)
+                {
+                    best = between;
+                    best_bin = i;
+                }
+            }
+
+            return HistMin + (HistMax - HistMin) * (best_bin + 1) / NumBins;
+        }
+    }
+
     public static class GridIO
     {
 
@@ -18,6 +142,34 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern void ReadWrite_WriteVdb(string path, int num_grids, IntPtr[] grids, int float_as_half);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr ReadWrite_ReadTiff(string path, double threshold, int threshold_mode, int crop, int reduction, int[] bbox_min, int[] bbox_max, ref TiffReadStats stats);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ReadWrite_ReadTiff")]
+        internal static extern IntPtr ReadWrite_ReadTiffNoStats(string path, double threshold, int threshold_mode, int crop, int reduction, int[] bbox_min, int[] bbox_max, IntPtr stats);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ReadWrite_ReadTiffVector")]
+        internal static extern IntPtr ReadWrite_ReadTiffVectorNoStats(string path, double threshold, int threshold_mode, int crop, int reduction, int[] bbox_min, int[] bbox_max, IntPtr stats);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ReadWrite_ReadTiffSequence")]
+        internal static extern IntPtr ReadWrite_ReadTiffSequenceNoStats(string path, double threshold, int threshold_mode, int crop, int reduction, double z_spacing, int num_threads,
+            int[] bbox_min, int[] bbox_max, IntPtr stats);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr ReadWrite_ReadVdbBands(string path);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int ReadWrite_ConvertTiff(string path, string out_path, double threshold, int threshold_mode, int reduction, int band_pages, int float_as_half);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ReadWrite_AppendTiff")]
+        internal static extern int ReadWrite_AppendTiffNoStats(IntPtr ptr, string path, double threshold, int threshold_mode, int crop, int reduction, int[] offset, int blend, IntPtr stats);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr ReadWrite_ReadRaw(string path, int width, int height, int depth, int sample_type, long header_bytes, double threshold);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern IntPtr ReadWrite_ReadMhd(string path, double threshold);
+
         
         #endregion
 
@@ -52,6 +204,15 @@ namespace DeepSight
                     case ("vec3s"):
                         grids[i] = new Vec3fGrid(grid_ptrs[i]);
                         break;
+                    case ("uint8"):
+                        grids[i] = new UInt8Grid(grid_ptrs[i]);
+                        break;
+                    case ("uint16"):
+                        grids[i] = new UInt16Grid(grid_ptrs[i]);
+                        break;
+                    case ("half"):
+                        grids[i] = new HalfGrid(grid_ptrs[i]);
+                        break;
                     default:
                         Console.WriteLine($"Unknown grid: {type}");
                         GridApi.GridBase_Delete(grid_ptrs[i]);
@@ -62,6 +223,106 @@ namespace DeepSight
             return grids.Where(x => x != null).ToArray();
         }
 
+        /// <summary>
+        /// Load a scalar multi-page TIFF, or a folder or pattern (e.g. "C:/scans/log_*.tif") of TIFF slices in natural order
+        /// of their names. bbox_min and bbox_max select an index-space region (x, y and page) and may be null.
+        /// With TiffThresholdMode.Percentile, threshold is the percentile (0 - 1), with TiffThresholdMode.Otsu it is ignored.
+        /// </summary>
+        public static FloatGrid ReadTiff(string filepath, double threshold = 1.0e-3, int crop = 0, int reduction = 1, int[] bbox_min = null, int[] bbox_max = null,
+            TiffThresholdMode threshold_mode = TiffThresholdMode.Fixed)
+        {
+            IntPtr ptr = ReadWrite_ReadTiffNoStats(filepath, threshold, (int)threshold_mode, crop, reduction, bbox_min, bbox_max, IntPtr.Zero);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
+        /// <summary>
+        /// Load a scalar multi-page TIFF and collect the statistics of the loaded values in the same pass.
+        /// The histogram range of stats has to be set before the call, e.g. with TiffReadStats.Create().
+        /// stats.Threshold receives the threshold the grid was loaded with.
+        /// </summary>
+        public static FloatGrid ReadTiff(string filepath, ref TiffReadStats stats, double threshold = 1.0e-3, int crop = 0, int reduction = 1, int[] bbox_min = null, int[] bbox_max = null,
+            TiffThresholdMode threshold_mode = TiffThresholdMode.Fixed)
+        {
+            if (stats.Histogram == null)
+                stats.Histogram = new ulong[TiffReadStats.NumBins];
+
+            IntPtr ptr = ReadWrite_ReadTiff(filepath, threshold, (int)threshold_mode, crop, reduction, bbox_min, bbox_max, ref stats);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
+        /// <summary>
+        /// Load a multi-page TIFF of vectors, or a folder or pattern of vector TIFF slices, one component per colour channel.
+        /// Unsigned integer channels are centred on zero (value / max - 0.5), float channels are kept as they are.
+        /// Vectors shorter than threshold are left out.
+        /// </summary>
+        public static Vec3fGrid ReadTiffVector(string filepath, double threshold = 1.0e-3, int crop = 0, int reduction = 1, int[] bbox_min = null, int[] bbox_max = null,
+            TiffThresholdMode threshold_mode = TiffThresholdMode.Fixed)
+        {
+            IntPtr ptr = ReadWrite_ReadTiffVectorNoStats(filepath, threshold, (int)threshold_mode, crop, reduction, bbox_min, bbox_max, IntPtr.Zero);
+            return ptr == IntPtr.Zero ? null : new Vec3fGrid(ptr);
+        }
+
+        /// <summary>
+        /// Load a folder or pattern (e.g. "C:/scans/log_*.tif") of TIFF slices, z_spacing pixels apart, decoding the slices
+        /// in parallel on num_threads threads (0 uses all cores). The other arguments are used as by ReadTiff.
+        /// </summary>
+        public static FloatGrid ReadTiffSequence(string filepath, double z_spacing = 1.0, double threshold = 1.0e-3, int crop = 0, int reduction = 1,
+            int[] bbox_min = null, int[] bbox_max = null, TiffThresholdMode threshold_mode = TiffThresholdMode.Fixed, int num_threads = 0)
+        {
+            IntPtr ptr = ReadWrite_ReadTiffSequenceNoStats(filepath, threshold, (int)threshold_mode, crop, reduction, z_spacing, num_threads, bbox_min, bbox_max, IntPtr.Zero);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
+        /// <summary>
+        /// Convert a multi-page TIFF, or a folder of TIFF slices, into one .vdb file per band of band_pages pages,
+        /// without holding the whole grid in memory. The bands go to log_0000.vdb, log_0001.vdb, ... for out_path log.vdb,
+        /// and ReadVdbBands merges them into one grid again. Returns the number of files written, or -1.
+        /// </summary>
+        public static int ConvertTiff(string filepath, string out_path, double threshold = 1.0e-3, int reduction = 1, int band_pages = 256,
+            bool float_as_half = false, TiffThresholdMode threshold_mode = TiffThresholdMode.Fixed)
+        {
+            return ReadWrite_ConvertTiff(filepath, out_path, threshold, (int)threshold_mode, reduction, band_pages, float_as_half ? 1 : 0);
+        }
+
+        /// <summary>
+        /// Read the band files written by ConvertTiff for out_path (log_0000.vdb, log_0001.vdb, ... for log.vdb)
+        /// and merge them into one grid.
+        /// </summary>
+        public static FloatGrid ReadVdbBands(string out_path)
+        {
+            IntPtr ptr = ReadWrite_ReadVdbBands(out_path);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
+        /// <summary>
+        /// Load a multi-page TIFF, or a folder of TIFF slices, into an existing grid, shifted by offset (x, y and z in voxels,
+        /// may be null). Where the grid already has active voxels, the new values are combined with them by blend.
+        /// The grid keeps its transform. Returns the number of pages appended, or -1.
+        /// </summary>
+        public static int AppendTiff(FloatGrid grid, string filepath, int[] offset = null, TiffBlendMode blend = TiffBlendMode.Max, double threshold = 1.0e-3,
+            int crop = 0, int reduction = 1, TiffThresholdMode threshold_mode = TiffThresholdMode.Fixed)
+        {
+            return ReadWrite_AppendTiffNoStats(grid.Ptr, filepath, threshold, (int)threshold_mode, crop, reduction, offset, (int)blend, IntPtr.Zero);
+        }
+
+        /// <summary>
+        /// Load an uncompressed little-endian volume, x varying fastest, then y, then z.
+        /// </summary>
+        public static FloatGrid ReadRaw(string filepath, int width, int height, int depth, RawSampleType sample_type, long header_bytes = 0, double threshold = 1.0e-3)
+        {
+            IntPtr ptr = ReadWrite_ReadRaw(filepath, width, height, depth, (int)sample_type, header_bytes, threshold);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
+        /// <summary>
+        /// Load the uncompressed volume described by a MetaImage header (.mhd or .mha).
+        /// </summary>
+        public static FloatGrid ReadMhd(string filepath, double threshold = 1.0e-3)
+        {
+            IntPtr ptr = ReadWrite_ReadMhd(filepath, threshold);
+            return ptr == IntPtr.Zero ? null : new FloatGrid(ptr);
+        }
+
         public static void Write(string filepath, GridApi[] grids, bool float_as_half=false)
         {
             ReadWrite_WriteVdb(filepath, grids.Length, grids.Select(x => x.Ptr).ToArray(), float_as_half ? 1 : 0);
@@ -28,6 +28,12 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void DoubleGrid_GetValuesIs(IntPtr ptr, int num_coords, int[] coords, double[] values);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void DoubleGrid_GetValuesWsSorted(IntPtr ptr, int num_coords, double[] coords, double[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void DoubleGrid_GetValuesIsSorted(IntPtr ptr, int num_coords, int[] coords, double[] values);
+
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void DoubleGrid_SetValues(IntPtr ptr, int num_coords, int[] coords, double[] values);
 
@@ -96,6 +102,28 @@ namespace DeepSight
             return values;
         }
 
+        /// <summary>
+        /// Same as GetValuesIndex and GetValuesWorld, but faster for scattered coordinates, which are visited
+        /// in Morton order of their leaf nodes. Values come back in the order of the coordinates.
+        /// </summary>
+        public double[] GetValuesIndexSorted(int[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            double[] values = new double[N];
+
+            DoubleGrid_GetValuesIsSorted(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public double[] GetValuesWorldSorted(double[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            double[] values = new double[N];
+
+            DoubleGrid_GetValuesWsSorted(Ptr, N, coordinates, values);
+            return values;
+        }
+
         public override void SetValues(int[] coordinates, double[] values)
         {
             DoubleGrid_SetValues(Ptr, coordinates.Length / 3, coordinates, values);
@@ -28,6 +28,12 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void FloatGrid_GetValuesIs(IntPtr ptr, int num_coords, int[] coords, float[] values);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void FloatGrid_GetValuesWsSorted(IntPtr ptr, int num_coords, double[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void FloatGrid_GetValuesIsSorted(IntPtr ptr, int num_coords, int[] coords, float[] values);
+
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void FloatGrid_SetValues(IntPtr ptr, int num_coords, int[] coords, float[] values);
 
@@ -100,6 +106,28 @@ namespace DeepSight
             return values;
         }
 
+        /// <summary>
+        /// Same as GetValuesIndex and GetValuesWorld, but faster for scattered coordinates, which are visited
+        /// in Morton order of their leaf nodes. Values come back in the order of the coordinates.
+        /// </summary>
+        public float[] GetValuesIndexSorted(int[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N];
+
+            FloatGrid_GetValuesIsSorted(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public float[] GetValuesWorldSorted(double[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N];
+
+            FloatGrid_GetValuesWsSorted(Ptr, N, coordinates, values);
+            return values;
+        }
+
         public override void SetValues(int[] coordinates, float[] values)
         {
             FloatGrid_SetValues(Ptr, coordinates.Length / 3, coordinates, values);
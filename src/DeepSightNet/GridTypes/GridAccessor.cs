@@ -0,0 +1,156 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace DeepSight
+{
+    /// <summary>
+    /// Accessor of a grid that keeps its cached tree nodes across calls, so that many nearby single-point
+    /// queries in a row skip most of the walk down from the root. The accessor stays bound to, and keeps
+    /// alive, the native grid it was created for.
+    /// Not safe to use from several threads at once.
+    /// </summary>
+    public abstract class GridAccessor<T> : IDisposable
+    {
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void GridAccessor_Delete(IntPtr ptr);
+
+        public IntPtr Ptr { get; protected set; }
+
+        public abstract T GetValue(int x, int y, int z);
+        public abstract bool GetActiveState(int x, int y, int z);
+
+        /// <summary>
+        /// Trilinear sample at fractional index coordinates.
+        /// </summary>
+        public abstract T SampleIndex(double x, double y, double z);
+
+        /// <summary>
+        /// Trilinear sample at world coordinates.
+        /// </summary>
+        public abstract T SampleWorld(double x, double y, double z);
+
+        ~GridAccessor()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            if (Ptr != IntPtr.Zero)
+            {
+                GridAccessor_Delete(Ptr);
+                Ptr = IntPtr.Zero;
+            }
+
+            if (disposing)
+                GC.SuppressFinalize(this);
+        }
+    }
+
+    public class FloatGridAccessor : GridAccessor<float>
+    {
+        #region Api calls
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr FloatGrid_CreateAccessor(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float FloatAccessor_GetValue(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int FloatAccessor_GetActiveState(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float FloatAccessor_SampleIs(IntPtr ptr, double x, double y, double z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float FloatAccessor_SampleWs(IntPtr ptr, double x, double y, double z);
+
+        #endregion
+
+        public FloatGridAccessor(FloatGrid grid)
+        {
+            Ptr = FloatGrid_CreateAccessor(grid.Ptr);
+            if (Ptr == IntPtr.Zero)
+                throw new ArgumentException("The native grid is not a FloatGrid.", nameof(grid));
+        }
+
+        public override float GetValue(int x, int y, int z) => FloatAccessor_GetValue(Ptr, x, y, z);
+        public override bool GetActiveState(int x, int y, int z) => FloatAccessor_GetActiveState(Ptr, x, y, z) != 0;
+        public override float SampleIndex(double x, double y, double z) => FloatAccessor_SampleIs(Ptr, x, y, z);
+        public override float SampleWorld(double x, double y, double z) => FloatAccessor_SampleWs(Ptr, x, y, z);
+    }
+
+    public class DoubleGridAccessor : GridAccessor<double>
+    {
+        #region Api calls
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr DoubleGrid_CreateAccessor(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern double DoubleAccessor_GetValue(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int DoubleAccessor_GetActiveState(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern double DoubleAccessor_SampleIs(IntPtr ptr, double x, double y, double z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern double DoubleAccessor_SampleWs(IntPtr ptr, double x, double y, double z);
+
+        #endregion
+
+        public DoubleGridAccessor(DoubleGrid grid)
+        {
+            Ptr = DoubleGrid_CreateAccessor(grid.Ptr);
+            if (Ptr == IntPtr.Zero)
+                throw new ArgumentException("The native grid is not a DoubleGrid.", nameof(grid));
+        }
+
+        public override double GetValue(int x, int y, int z) => DoubleAccessor_GetValue(Ptr, x, y, z);
+        public override bool GetActiveState(int x, int y, int z) => DoubleAccessor_GetActiveState(Ptr, x, y, z) != 0;
+        public override double SampleIndex(double x, double y, double z) => DoubleAccessor_SampleIs(Ptr, x, y, z);
+        public override double SampleWorld(double x, double y, double z) => DoubleAccessor_SampleWs(Ptr, x, y, z);
+    }
+
+    public class Int32GridAccessor : GridAccessor<int>
+    {
+        #region Api calls
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr Int32Grid_CreateAccessor(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int Int32Accessor_GetValue(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int Int32Accessor_GetActiveState(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int Int32Accessor_SampleIs(IntPtr ptr, double x, double y, double z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int Int32Accessor_SampleWs(IntPtr ptr, double x, double y, double z);
+
+        #endregion
+
+        public Int32GridAccessor(Int32Grid grid)
+        {
+            Ptr = Int32Grid_CreateAccessor(grid.Ptr);
+            if (Ptr == IntPtr.Zero)
+                throw new ArgumentException("The native grid is not a Int32Grid.", nameof(grid));
+        }
+
+        public override int GetValue(int x, int y, int z) => Int32Accessor_GetValue(Ptr, x, y, z);
+        public override bool GetActiveState(int x, int y, int z) => Int32Accessor_GetActiveState(Ptr, x, y, z) != 0;
+        public override int SampleIndex(double x, double y, double z) => Int32Accessor_SampleIs(Ptr, x, y, z);
+        public override int SampleWorld(double x, double y, double z) => Int32Accessor_SampleWs(Ptr, x, y, z);
+    }
+}
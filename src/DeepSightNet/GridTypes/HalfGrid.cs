@@ -0,0 +1,118 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using System.Runtime.InteropServices;
+
+namespace DeepSight
+{
+    /// <summary>
+    /// Grid of 16-bit float values.
+    /// </summary>
+    public class HalfGrid : QuantizedGrid
+    {
+        #region Api calls
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr GridBase_CreateHalf(float background);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float HalfGrid_GetValueWs(IntPtr ptr, double x, double y, double z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float HalfGrid_GetValueIs(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_SetValue(IntPtr ptr, int x, int y, int z, float v);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_GetValuesWs(IntPtr ptr, int num_coords, double[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_GetValuesIs(IntPtr ptr, int num_coords, int[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_SetValues(IntPtr ptr, int num_coords, int[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_GetActiveVoxels(IntPtr ptr, int[] coords);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_SetActiveState(IntPtr ptr, int[] coord, int state);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void HalfGrid_SetActiveStates(IntPtr ptr, int num_coords, int[] coord, int[] state);
+
+        #endregion
+
+        public HalfGrid(IntPtr ptr)
+        {
+            Ptr = ptr;
+        }
+
+        public HalfGrid(string name="default", float background=0.0f)
+        {
+            Ptr = GridBase_CreateHalf(background);
+            Name = name;
+        }
+
+        public override GridApi Duplicate()
+        {
+            return new HalfGrid(GridApi.GridBase_Duplicate(Ptr));
+        }
+
+        public override float GetValueIndex(int[] coordinates) =>
+            HalfGrid_GetValueIs(Ptr, coordinates[0], coordinates[1], coordinates[2]);
+
+        public override float GetValueWorld(double[] coordinates) =>
+            HalfGrid_GetValueWs(Ptr, coordinates[0], coordinates[1], coordinates[2]);
+
+        public override void SetValue(int[] coordinates, float value) =>
+            HalfGrid_SetValue(Ptr, coordinates[0], coordinates[1], coordinates[2], value);
+
+        public override float[] GetValuesIndex(int[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N];
+
+            HalfGrid_GetValuesIs(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public override float[] GetValuesWorld(double[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N];
+
+            HalfGrid_GetValuesWs(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public override void SetValues(int[] coordinates, float[] values)
+        {
+            HalfGrid_SetValues(Ptr, coordinates.Length / 3, coordinates, values);
+        }
+
+        public override int[] GetActiveVoxels()
+        {
+            int[] coords = new int[GridBase_GetActiveVoxelCount(Ptr) * 3];
+            HalfGrid_GetActiveVoxels(Ptr, coords);
+            return coords;
+        }
+
+        public override void SetActiveState(int[] coordinates, bool on)
+        {
+            HalfGrid_SetActiveState(Ptr, coordinates, on ? 1 : 0);
+        }
+
+        public override void SetActiveStates(int[] coordinates, bool[] on)
+        {
+            HalfGrid_SetActiveStates(Ptr, coordinates.Length / 3, coordinates, on.Select(x => (x ? 1 : 0)).ToArray());
+        }
+
+        public override string ToString()
+        {
+            return $"HalfGrid ({Name})";
+        }
+    }
+}
@@ -28,6 +28,12 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void Int32Grid_GetValuesIs(IntPtr ptr, int num_coords, int[] coords, int[] values);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void Int32Grid_GetValuesWsSorted(IntPtr ptr, int num_coords, double[] coords, int[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void Int32Grid_GetValuesIsSorted(IntPtr ptr, int num_coords, int[] coords, int[] values);
+
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void Int32Grid_SetValues(IntPtr ptr, int num_coords, int[] coords, int[] values);
 
@@ -96,6 +102,28 @@ namespace DeepSight
             return values;
         }
 
+        /// <summary>
+        /// Same as GetValuesIndex and GetValuesWorld, but faster for scattered coordinates, which are visited
+        /// in Morton order of their leaf nodes. Values come back in the order of the coordinates.
+        /// </summary>
+        public int[] GetValuesIndexSorted(int[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            int[] values = new int[N];
+
+            Int32Grid_GetValuesIsSorted(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public int[] GetValuesWorldSorted(double[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            int[] values = new int[N];
+
+            Int32Grid_GetValuesWsSorted(Ptr, N, coordinates, values);
+            return values;
+        }
+
         public override void SetValues(int[] coordinates, int[] values)
         {
             Int32Grid_SetValues(Ptr, coordinates.Length / 3, coordinates, values);
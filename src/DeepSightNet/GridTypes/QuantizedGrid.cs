@@ -0,0 +1,114 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using System.Runtime.InteropServices;
+
+namespace DeepSight
+{
+    /// <summary>
+    /// Storage type of a quantized grid.
+    /// </summary>
+    public enum QuantizedType
+    {
+        UInt8 = 0,
+        UInt16 = 1,
+        Half = 2
+    }
+
+    /// <summary>
+    /// Grid that stores its values as 8-bit or 16-bit integers or as half floats. Values
+    /// are encoded with a scale and offset on the way in and decoded to float on the way out.
+    /// Filters, resampling and combining decode the whole grid into a temporary FloatGrid,
+    /// so memory peaks at the float footprint while they run.
+    /// </summary>
+    public abstract class QuantizedGrid : GridBase<float>
+    {
+        #region Api calls
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr GridBase_Quantize(IntPtr ptr, int type, float min, float max);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr GridBase_Dequantize(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void GridBase_GetQuantization(IntPtr ptr, ref float scale, ref float offset);
+
+        #endregion
+
+        /// <summary>
+        /// Quantize a FloatGrid. Values between min and max are kept, if min >= max the
+        /// range of the grid is used.
+        /// </summary>
+        /// <returns>A new UInt8Grid, UInt16Grid or HalfGrid, or null.</returns>
+        public static QuantizedGrid Quantize(FloatGrid grid, QuantizedType type, float min = 0.0f, float max = 0.0f)
+        {
+            IntPtr ptr = GridBase_Quantize(grid.Ptr, (int)type, min, max);
+            if (ptr == IntPtr.Zero) return null;
+
+            switch (type)
+            {
+                case (QuantizedType.UInt8):
+                    return new UInt8Grid(ptr);
+                case (QuantizedType.UInt16):
+                    return new UInt16Grid(ptr);
+                default:
+                    return new HalfGrid(ptr);
+            }
+        }
+
+        /// <summary>
+        /// Decode into a new FloatGrid.
+        /// </summary>
+        public FloatGrid Dequantize()
+        {
+            return new FloatGrid(GridBase_Dequantize(Ptr));
+        }
+
+        /// <summary>
+        /// Decoded value = Offset + Scale * stored value.
+        /// </summary>
+        public float Scale
+        {
+            get
+            {
+                float scale = 1.0f, offset = 0.0f;
+                GridBase_GetQuantization(Ptr, ref scale, ref offset);
+                return scale;
+            }
+        }
+
+        public float Offset
+        {
+            get
+            {
+                float scale = 1.0f, offset = 0.0f;
+                GridBase_GetQuantization(Ptr, ref scale, ref offset);
+                return offset;
+            }
+        }
+
+        public override float[] GetNeighbours(int[] coordinates)
+        {
+            var coords = new int[27 * 3];
+            int n = 0;
+
+            for (int k = -1; k < 2; ++k)
+                for (int j = -1; j < 2; ++j)
+                    for (int i = -1; i < 2; ++i)
+                    {
+                        coords[n++] = coordinates[0] + i;
+                        coords[n++] = coordinates[1] + j;
+                        coords[n++] = coordinates[2] + k;
+                    }
+
+            return GetValuesIndex(coords);
+        }
+
+        public override object GetGridValue(int x, int y, int z)
+        {
+            return (object)this[x, y, z];
+        }
+    }
+}
@@ -0,0 +1,118 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using System.Runtime.InteropServices;
+
+namespace DeepSight
+{
+    /// <summary>
+    /// Grid of 8-bit values, decoded as Offset + Scale * value.
+    /// </summary>
+    public class UInt8Grid : QuantizedGrid
+    {
+        #region Api calls
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr GridBase_CreateUInt8(float scale, float offset, float background);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float UInt8Grid_GetValueWs(IntPtr ptr, double x, double y, double z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern float UInt8Grid_GetValueIs(IntPtr ptr, int x, int y, int z);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_SetValue(IntPtr ptr, int x, int y, int z, float v);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_GetValuesWs(IntPtr ptr, int num_coords, double[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_GetValuesIs(IntPtr ptr, int num_coords, int[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_SetValues(IntPtr ptr, int num_coords, int[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_GetActiveVoxels(IntPtr ptr, int[] coords);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_SetActiveState(IntPtr ptr, int[] coord, int state);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void UInt8Grid_SetActiveStates(IntPtr ptr, int num_coords, int[] coord, int[] state);
+
+        #endregion
+
+        public UInt8Grid(IntPtr ptr)
+        {
+            Ptr = ptr;
+        }
+
+        public UInt8Grid(string name="default", float scale=1.0f / 255.0f, float offset=0.0f, float background=0.0f)
+        {
+            Ptr = GridBase_CreateUInt8(scale, offset, background);
+            Name = name;
+        }
+
+        public override GridApi Duplicate()
+        {
+            return new UInt8Grid(GridApi.GridBase_Duplicate(Ptr));
+        }
+
+        public override float GetValueIndex(int[] coordinates) =>
+            UInt8Grid_GetValueIs(Ptr, coordinates[0], coordinates[1], coordinates[2]);
+
+        public override float GetValueWorld(double[] coordinates) =>
+            UInt8Grid_GetValueWs(Ptr, coordinates[0], coordinates[1], coordinates[2]);
+
+        public override void SetValue(int[] coordinates, float value) =>
+            UInt8Grid_SetValue(Ptr, coordinates[0], coordinates[1], coordinates[2], value);
+
+        public override float[] GetValuesIndex(int[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N];
+
+            UInt8Grid_GetValuesIs(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public override float[] GetValuesWorld(double[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N];
+
+            UInt8Grid_GetValuesWs(Ptr, N, coordinates, values);
+            return values;
+        }
+
+        public override void SetValues(int[] coordinates, float[] values)
+        {
+            UInt8Grid_SetValues(Ptr, coordinates.Length / 3, coordinates, values);
+        }
+
+        public override int[] GetActiveVoxels()
+        {
+            int[] coords = new int[GridBase_GetActiveVoxelCount(Ptr) * 3];
+            UInt8Grid_GetActiveVoxels(Ptr, coords);
+            return coords;
+        }
+
+        public override void SetActiveState(int[] coordinates, bool on)
+        {
+            UInt8Grid_SetActiveState(Ptr, coordinates, on ? 1 : 0);
+        }
+
+        public override void SetActiveStates(int[] coordinates, bool[] on)
+        {
+            UInt8Grid_SetActiveStates(Ptr, coordinates.Length / 3, coordinates, on.Select(x => (x ? 1 : 0)).ToArray());
+        }
+
+        public override string ToString()
+        {
+            return $"UInt8Grid ({Name})";
+        }
+    }
+}
@@ -31,6 +31,12 @@ namespace DeepSight
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void Vec3fGrid_GetValuesIs(IntPtr ptr, int num_coords, int[] coords, float[] values);
 
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void Vec3fGrid_GetValuesWsSorted(IntPtr ptr, int num_coords, double[] coords, float[] values);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void Vec3fGrid_GetValuesIsSorted(IntPtr ptr, int num_coords, int[] coords, float[] values);
+
         [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         private static extern void Vec3fGrid_SetValues(IntPtr ptr, int num_coords, int[] coords, float[] values);
 
@@ -127,6 +133,40 @@ namespace DeepSight
             return vecs;
         }
 
+        /// <summary>
+        /// Same as GetValuesIndex and GetValuesWorld, but faster for scattered coordinates, which are visited
+        /// in Morton order of their leaf nodes. Values come back in the order of the coordinates.
+        /// </summary>
+        public Vec3f[] GetValuesIndexSorted(int[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N * 3];
+
+            Vec3fGrid_GetValuesIsSorted(Ptr, N, coordinates, values);
+            return ToVectors(values);
+        }
+
+        public Vec3f[] GetValuesWorldSorted(double[] coordinates)
+        {
+            int N = coordinates.Length / 3;
+            float[] values = new float[N * 3];
+
+            Vec3fGrid_GetValuesWsSorted(Ptr, N, coordinates, values);
+            return ToVectors(values);
+        }
+
+        private static Vec3f[] ToVectors(float[] values)
+        {
+            Vec3f[] vecs = new Vec3f[values.Length / 3];
+            for (int i = 0; i < vecs.Length; ++i)
+                vecs[i] = new Vec3f(
+                    values[i * 3 + 0],
+                    values[i * 3 + 1],
+                    values[i * 3 + 2]);
+
+            return vecs;
+        }
+
         public override void SetValues(int[] coordinates, Vec3f[] values)
         {
             float[] values_raw = new float[values.Length * 3];
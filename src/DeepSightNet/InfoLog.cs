@@ -64,4 +64,157 @@ namespace DeepSight
 
         }
     }
+
+    /// <summary>
+    /// Knot record of an InfoLogView. Mirrors RawLam::knot.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct KnotRecord
+    {
+        public float Radius;
+        public float Length;
+        public float Volume;
+        public int Index;
+        public int DeadKnotBorder;
+        public float StartX, StartY, StartZ;
+        public float EndX, EndY, EndZ;
+    }
+
+    /// <summary>
+    /// InfoLog that stays on the native side. The pointers refer to its arrays in place and stay
+    /// valid until the view is disposed, so they can be wrapped without copying, e.g. as spans.
+    /// Outlines are stored back to back: outline i is made of the points Offset(i) up to Offset(i + 1).
+    /// </summary>
+    public class InfoLogView : IDisposable
+    {
+        #region Api calls
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr InfoLog_Open(string filepath);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLog_Delete(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLog_GetPith(IntPtr ptr, out int n_pith, out IntPtr pith);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLog_GetKnots(IntPtr ptr, out int n_knots, out IntPtr knots);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLog_GetBorder(IntPtr ptr, out int n_outlines, out IntPtr offsets, out long n_points, out IntPtr points);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLog_GetSapwood(IntPtr ptr, out int n_outlines, out IntPtr offsets, out long n_points, out IntPtr points);
+
+        #endregion
+
+        /// <summary>
+        /// Outlines of all slices, as offsets into one array of (x, y) float pairs.
+        /// </summary>
+        public struct Outlines
+        {
+            public int Count;
+            public IntPtr Offsets;
+            public long PointCount;
+            public IntPtr Points;
+
+            public long Offset(int i)
+            {
+                return Marshal.ReadInt64(Offsets, i * sizeof(long));
+            }
+
+            /// <summary>
+            /// Copy outline i out as (x, y) pairs.
+            /// </summary>
+            public float[] GetOutline(int i)
+            {
+                long first = Offset(i);
+                var points = new float[(Offset(i + 1) - first) * 2];
+                // The offset is added as 64 bits, as the points of all outlines may span more than 2 GB
+                Marshal.Copy(new IntPtr(Points.ToInt64() + first * 2 * sizeof(float)), points, 0, points.Length);
+                return points;
+            }
+        }
+
+        public IntPtr Ptr { get; private set; }
+
+        public int PithCount { get; private set; }
+        public IntPtr Pith { get; private set; }
+
+        public int KnotCount { get; private set; }
+        public IntPtr Knots { get; private set; }
+
+        public Outlines Border { get; private set; }
+        public Outlines Sapwood { get; private set; }
+
+        // Set for views of InfoLogs that belong to someone else, e.g. an InfoLogCatalog, which is kept alive with them
+        private readonly object m_owner = null;
+
+        public InfoLogView(string filepath)
+        {
+            Ptr = InfoLog_Open(filepath);
+            if (Ptr == IntPtr.Zero)
+                throw new Exception($"Failed to load InfoLog '{filepath}'");
+
+            ReadPointers();
+        }
+
+        internal InfoLogView(IntPtr ptr, object owner)
+        {
+            Ptr = ptr;
+            m_owner = owner;
+
+            ReadPointers();
+        }
+
+        private void ReadPointers()
+        {
+            InfoLog_GetPith(Ptr, out int n_pith, out IntPtr pith);
+            PithCount = n_pith;
+            Pith = pith;
+
+            InfoLog_GetKnots(Ptr, out int n_knots, out IntPtr knots);
+            KnotCount = n_knots;
+            Knots = knots;
+
+            var border = new Outlines();
+            InfoLog_GetBorder(Ptr, out border.Count, out border.Offsets, out border.PointCount, out border.Points);
+            Border = border;
+
+            var sapwood = new Outlines();
+            InfoLog_GetSapwood(Ptr, out sapwood.Count, out sapwood.Offsets, out sapwood.PointCount, out sapwood.Points);
+            Sapwood = sapwood;
+        }
+
+        public KnotRecord GetKnot(int i)
+        {
+            return Marshal.PtrToStructure<KnotRecord>(Knots + i * Marshal.SizeOf<KnotRecord>());
+        }
+
+        ~InfoLogView()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            if (Ptr != IntPtr.Zero)
+            {
+                if (m_owner == null)
+                    InfoLog_Delete(Ptr);
+                Ptr = IntPtr.Zero;
+                Pith = Knots = IntPtr.Zero;
+                Border = Sapwood = new Outlines();
+            }
+
+            if (disposing)
+                GC.SuppressFinalize(this);
+        }
+    }
 }
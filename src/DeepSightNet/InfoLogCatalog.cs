@@ -0,0 +1,155 @@
+﻿/*
+ * DeepSight
+ * Copyright 2023 Tom Svilans
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ */
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+
+namespace DeepSight
+{
+    /// <summary>
+    /// Summary of a log in an InfoLogCatalog. Mirrors RawLam::InfoLogSummary.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct InfoLogSummary
+    {
+        public int KnotCount;
+        public int SliceCount;
+        public double KnotVolume;
+        public double PithLength;
+    }
+
+    /// <summary>
+    /// InfoLogs of many logs, loaded in parallel on the native side and kept by the name of their file
+    /// without extension. Summaries are read in place, and logs are handed out as InfoLogViews that
+    /// belong to the catalog.
+    /// </summary>
+    public class InfoLogCatalog : IDisposable
+    {
+        #region Api calls
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr InfoLogCatalog_Create(double z_spacing);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLogCatalog_Delete(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int InfoLogCatalog_Load(IntPtr ptr, int num_paths, string[] paths, int use_cache);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int InfoLogCatalog_Find(IntPtr ptr, string name);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr InfoLogCatalog_GetName(IntPtr ptr, int i);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void InfoLogCatalog_GetSummaries(IntPtr ptr, out int n_logs, out IntPtr summaries);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr InfoLogCatalog_GetLog(IntPtr ptr, int i);
+
+        #endregion
+
+        public IntPtr Ptr { get; private set; }
+
+        /// <summary>
+        /// Pith lengths of the summaries take slices to be z_spacing apart.
+        /// </summary>
+        public InfoLogCatalog(double z_spacing = 1.0)
+        {
+            Ptr = InfoLogCatalog_Create(z_spacing);
+        }
+
+        /// <summary>
+        /// Load InfoLogs in parallel. A log named like one in the catalog replaces it, which also
+        /// invalidates the views of the old one. Returns the number of logs loaded.
+        /// </summary>
+        public int Load(IEnumerable<string> paths, bool use_cache = true)
+        {
+            var path_array = paths.ToArray();
+            return InfoLogCatalog_Load(Ptr, path_array.Length, path_array, use_cache ? 1 : 0);
+        }
+
+        public int Count
+        {
+            get
+            {
+                InfoLogCatalog_GetSummaries(Ptr, out int n_logs, out IntPtr summaries);
+                return n_logs;
+            }
+        }
+
+        /// <summary>
+        /// Position of the log called name, or -1.
+        /// </summary>
+        public int Find(string name)
+        {
+            return InfoLogCatalog_Find(Ptr, name);
+        }
+
+        public string GetName(int i)
+        {
+            return Marshal.PtrToStringAnsi(InfoLogCatalog_GetName(Ptr, i));
+        }
+
+        public InfoLogSummary GetSummary(int i)
+        {
+            InfoLogCatalog_GetSummaries(Ptr, out int n_logs, out IntPtr summaries);
+            if (i < 0 || i >= n_logs)
+                throw new IndexOutOfRangeException();
+
+            return Marshal.PtrToStructure<InfoLogSummary>(summaries + i * Marshal.SizeOf<InfoLogSummary>());
+        }
+
+        /// <summary>
+        /// View of the log at position i. It stays valid while the catalog is alive and the log is not replaced.
+        /// </summary>
+        public InfoLogView GetLog(int i)
+        {
+            IntPtr ptr = InfoLogCatalog_GetLog(Ptr, i);
+            if (ptr == IntPtr.Zero)
+                throw new IndexOutOfRangeException();
+
+            return new InfoLogView(ptr, this);
+        }
+
+        ~InfoLogCatalog()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            if (Ptr != IntPtr.Zero)
+            {
+                InfoLogCatalog_Delete(Ptr);
+                Ptr = IntPtr.Zero;
+            }
+
+            if (disposing)
+                GC.SuppressFinalize(this);
+        }
+    }
+}
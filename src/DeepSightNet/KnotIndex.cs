@@ -0,0 +1,139 @@
+﻿/*
+ * RawLamb
+ * Copyright 2022 Tom Svilans
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ */
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace DeepSight
+{
+    /// <summary>
+    /// Bounding-volume hierarchy over the knots of an InfoLog, each knot taken as a capsule around the
+    /// segment from its start to its end. Queries return positions in the knot array of the InfoLog.
+    /// Coordinates are passed as flat (x, y, z) arrays, one triple per query.
+    /// </summary>
+    public class KnotIndex : IDisposable
+    {
+        #region Api calls
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr KnotIndex_Create(IntPtr infolog);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void KnotIndex_Delete(IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void KnotIndex_QueryBoxes(IntPtr ptr, int num_queries, float[] min, float[] max, out IntPtr offsets, out int n_hits, out IntPtr hits);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void KnotIndex_QuerySegments(IntPtr ptr, int num_queries, float[] a, float[] b, out IntPtr offsets, out int n_hits, out IntPtr hits);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void KnotIndex_free(ref IntPtr ptr);
+
+        [DllImport(Api.DeepSightApiPath, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void KnotIndex_Nearest(IntPtr ptr, int num_points, float[] points, float max_distance, int[] knots, float[] distances);
+
+        #endregion
+
+        public IntPtr Ptr { get; private set; }
+
+        public KnotIndex(InfoLogView infolog)
+        {
+            Ptr = KnotIndex_Create(infolog.Ptr);
+        }
+
+        /// <summary>
+        /// Knots overlapping each box, given by its min and max corners.
+        /// </summary>
+        public int[][] QueryBoxes(float[] min, float[] max)
+        {
+            int num_queries = Math.Min(min.Length, max.Length) / 3;
+            KnotIndex_QueryBoxes(Ptr, num_queries, min, max, out IntPtr offsets, out int n_hits, out IntPtr hits);
+
+            return SplitHits(num_queries, offsets, n_hits, hits);
+        }
+
+        /// <summary>
+        /// Knots touched by each segment from a to b. Rays can be queried as long segments.
+        /// </summary>
+        public int[][] QuerySegments(float[] a, float[] b)
+        {
+            int num_queries = Math.Min(a.Length, b.Length) / 3;
+            KnotIndex_QuerySegments(Ptr, num_queries, a, b, out IntPtr offsets, out int n_hits, out IntPtr hits);
+
+            return SplitHits(num_queries, offsets, n_hits, hits);
+        }
+
+        /// <summary>
+        /// Nearest knot to each point, or -1 if none is within max_distance, and the distance to its surface (0 inside).
+        /// </summary>
+        public int[] Nearest(float[] points, out float[] distances, float max_distance = float.MaxValue)
+        {
+            int num_points = points.Length / 3;
+            var knots = new int[num_points];
+            distances = new float[num_points];
+
+            KnotIndex_Nearest(Ptr, num_points, points, max_distance, knots, distances);
+            return knots;
+        }
+
+        private static int[][] SplitHits(int num_queries, IntPtr offsets_ptr, int n_hits, IntPtr hits_ptr)
+        {
+            var offsets = new int[num_queries + 1];
+            var hits = new int[n_hits];
+
+            Marshal.Copy(offsets_ptr, offsets, 0, offsets.Length);
+            if (n_hits > 0)
+                Marshal.Copy(hits_ptr, hits, 0, n_hits);
+
+            KnotIndex_free(ref offsets_ptr);
+            KnotIndex_free(ref hits_ptr);
+
+            var result = new int[num_queries][];
+            for (int i = 0; i < num_queries; ++i)
+            {
+                result[i] = new int[offsets[i + 1] - offsets[i]];
+                Array.Copy(hits, offsets[i], result[i], 0, result[i].Length);
+            }
+
+            return result;
+        }
+
+        ~KnotIndex()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            if (Ptr != IntPtr.Zero)
+            {
+                KnotIndex_Delete(Ptr);
+                Ptr = IntPtr.Zero;
+            }
+
+            if (disposing)
+                GC.SuppressFinalize(this);
+        }
+    }
+}
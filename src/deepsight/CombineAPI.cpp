@@ -238,4 +238,37 @@ namespace DeepSight
 			break;
 		}
 	}
+
+	void QuantizedGrid_combine(GridBase* ptr0, GridBase* ptr1, int type)
+	{
+		GridBase* decoded0 = dequantize_grid(ptr0);
+		if (decoded0 == nullptr || ptr1 == nullptr)
+		{
+			delete decoded0;
+			return;
+		}
+
+		GridBase* decoded1 = is_quantized(*ptr1->m_grid) ? dequantize_grid(ptr1) : nullptr;
+
+		FloatGrid_combine(decoded0, decoded1 != nullptr ? decoded1 : ptr1, type);
+
+		// The second decoded grid is not needed for encoding, so it is freed first
+		delete decoded1;
+
+		requantize_grid(ptr0, *openvdb::gridPtrCast<openvdb::FloatGrid>(decoded0->m_grid));
+
+		delete decoded0;
+	}
+
+	void Scalar_QuantizedGrid_combine(GridBase* ptr0, float n, int type)
+	{
+		GridBase* decoded = dequantize_grid(ptr0);
+		if (decoded == nullptr)
+			return;
+
+		Scalar_FloatGrid_combine(decoded, n, type);
+		requantize_grid(ptr0, *openvdb::gridPtrCast<openvdb::FloatGrid>(decoded->m_grid));
+
+		delete decoded;
+	}
 }
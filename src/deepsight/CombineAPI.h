@@ -4,6 +4,7 @@
 #include "Composite_ext.h"
 
 #include "GridBase.h"
+#include "QuantizedGrid.h"
 
 namespace DeepSight
 {
@@ -14,6 +15,12 @@ namespace DeepSight
 	DEEPSIGHT_EXPORT void Scalar_FloatGrid_combine(GridBase* ptr0, float n, int type);
 	DEEPSIGHT_EXPORT void Vec3fGrid_combine(GridBase* ptr0, GridBase* ptr1, int type);
 
+	// Combine through float and encode the result with the quantization of ptr0.
+	// ptr1 may be a float grid or a quantized grid. Quantized grids are decoded whole
+	// into temporary float grids, so memory peaks at their float footprint.
+	DEEPSIGHT_EXPORT void QuantizedGrid_combine(GridBase* ptr0, GridBase* ptr1, int type);
+	DEEPSIGHT_EXPORT void Scalar_QuantizedGrid_combine(GridBase* ptr0, float n, int type);
+
 #ifdef __cplusplus
 	}
 #endif
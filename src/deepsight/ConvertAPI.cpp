@@ -42,6 +42,25 @@ namespace DeepSight
 		return volume_from_points(num_points, point_data, radius, voxelsize);
 	}
 
+	GridBase* FloatGrid_FromKnots(RawLam::InfoLog* infolog, GridBase* reference, float half_width, GridBase** index_grid)
+	{
+		if (index_grid)
+			*index_grid = nullptr;
+
+		if (!infolog || !reference)
+			return nullptr;
+
+		return volume_from_knots(infolog->knots, reference->m_grid->transform(), half_width, index_grid);
+	}
+
+	GridBase* Int32Grid_FromOutlines(RawLam::InfoLog* infolog, GridBase* reference, double z_origin, double z_spacing)
+	{
+		if (!infolog || !reference)
+			return nullptr;
+
+		return outline_labels(*infolog, reference->m_grid->transform(), z_origin, z_spacing);
+	}
+
 	Mesh* DoubleGrid_ToMesh(GridBase* ptr, float isovalue)
 	{
 		auto mesh = new Mesh();
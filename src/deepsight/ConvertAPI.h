@@ -12,6 +12,14 @@ namespace DeepSight
 	DEEPSIGHT_EXPORT Mesh* FloatGrid_ToMesh(GridBase* ptr, float isovalue);
 	DEEPSIGHT_EXPORT GridBase* FloatGrid_FromMesh(Mesh* mesh, float* xform, float isovalue, float exteriorBandWidth, float interiorBandWidth);
 	DEEPSIGHT_EXPORT GridBase* FloatGrid_FromPoints(int num_points, float* point_data, float radius, float voxelsize);
+
+	// Level set of the knots of an InfoLog (see InfoLog_Open), with the transform of the grid reference.
+	// index_grid may be null, otherwise it receives an Int32Grid of the nearest knot of every voxel of the band.
+	DEEPSIGHT_EXPORT GridBase* FloatGrid_FromKnots(RawLam::InfoLog* infolog, GridBase* reference, float half_width, GridBase** index_grid);
+
+	// Int32Grid of heartwood, sapwood and outside labels (see OutlineLabel) filled from the outlines of an
+	// InfoLog, with the transform of the grid reference. Outline i lies at world z = z_origin + i * z_spacing.
+	DEEPSIGHT_EXPORT GridBase* Int32Grid_FromOutlines(RawLam::InfoLog* infolog, GridBase* reference, double z_origin, double z_spacing);
 	DEEPSIGHT_EXPORT Mesh* DoubleGrid_ToMesh(GridBase* ptr, float isovalue);
 	DEEPSIGHT_EXPORT Mesh* Int32Grid_ToMesh(GridBase* ptr, float isovalue);
 
@@ -1,4 +1,5 @@
 #include "Grid.h"
+#include "GridBase.h"
 
 namespace DeepSight
 {
@@ -374,18 +375,23 @@ namespace DeepSight
 	}
 
 	template <typename T>
-	std::vector<T> Grid<T>::get_interpolated_values(std::vector<Eigen::Vector3f>& xyz, unsigned int sample_type)
+	std::vector<T> Grid<T>::get_interpolated_values(std::vector<Eigen::Vector3f>& xyz, unsigned int sample_type, bool sorted)
 	{
 		auto accessor = m_grid->getConstAccessor();
 		std::vector<ValueT> values(xyz.size());
 
+		std::vector<uint32_t> order;
+		if (sorted)
+			order = morton_order(xyz.size(), reinterpret_cast<const float*>(xyz.data()), m_grid->transform());
+
 		switch (sample_type)
 		{
 		case(1):
 		{
 			openvdb::tools::GridSampler<GridT::ConstAccessor, openvdb::tools::BoxSampler> sampler1(accessor, m_grid->transform());
-			for (int i = 0; i < xyz.size(); ++i)
+			for (size_t j = 0; j < xyz.size(); ++j)
 			{
+				size_t i = sorted ? order[j] : j;
 				values[i] = sampler1.wsSample(
 					openvdb::Vec3R(xyz[i].x(), xyz[i].y(), xyz[i].z()));
 			}
@@ -395,8 +401,9 @@ namespace DeepSight
 		{
 			openvdb::tools::GridSampler<GridT::ConstAccessor, openvdb::tools::QuadraticSampler> sampler2(accessor, m_grid->transform());
 
-			for (int i = 0; i < xyz.size(); ++i)
+			for (size_t j = 0; j < xyz.size(); ++j)
 			{
+				size_t i = sorted ? order[j] : j;
 				values[i] = sampler2.wsSample(
 					openvdb::Vec3R(xyz[i].x(), xyz[i].y(), xyz[i].z()));
 			}
@@ -406,8 +413,9 @@ namespace DeepSight
 		{
 			openvdb::tools::GridSampler<GridT::ConstAccessor, openvdb::tools::PointSampler> sampler3(accessor, m_grid->transform());
 
-			for (int i = 0; i < xyz.size(); ++i)
+			for (size_t j = 0; j < xyz.size(); ++j)
 			{
+				size_t i = sorted ? order[j] : j;
 				values[i] = sampler3.wsSample(
 					openvdb::Vec3R(xyz[i].x(), xyz[i].y(), xyz[i].z()));
 			}
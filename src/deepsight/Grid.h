@@ -77,7 +77,8 @@ namespace DeepSight
 		std::vector<Eigen::Vector3i> get_active_voxels();
 
 		T get_interpolated_value(Eigen::Vector3f xyz);
-		std::vector<T> get_interpolated_values(std::vector<Eigen::Vector3f>& xyz, unsigned int sample_type = 1);
+		// With sorted, samples are taken in morton_order (see GridBase.h) and returned in the order of xyz
+		std::vector<T> get_interpolated_values(std::vector<Eigen::Vector3f>& xyz, unsigned int sample_type = 1, bool sorted = false);
 
 		Eigen::Matrix<T, 27, 1> get_neighbourhood(Eigen::Vector3i xyz);
 
@@ -0,0 +1,74 @@
+#ifndef GRID_ACCESSOR_H
+#define GRID_ACCESSOR_H
+
+#include "GridBase.h"
+
+namespace DeepSight
+{
+	// Untyped handle of a GridAccessor, so that one delete serves all grid types in the C API
+	class GridAccessorBase
+	{
+	public:
+		virtual ~GridAccessorBase() {}
+	};
+
+	/*
+	Accessor of a grid that lives across calls. Every query starts from the nodes cached by
+	the previous one, so consecutive nearby queries skip most of the walk down from the root
+	that GridBase::get_value_is and get_value_ws take every time. It stays bound to, and keeps
+	alive, the grid it was created for: it picks up a new tree or transform of that grid, but
+	not a different grid assigned to the GridBase afterwards. The grid has to be a GridT. An
+	accessor is not safe to use from several threads at once.
+	*/
+	template<typename GridT>
+	class GridAccessor : public GridAccessorBase
+	{
+	public:
+		using ValueT = typename GridT::ValueType;
+		using AccessorT = typename GridT::ConstAccessor;
+
+		GridAccessor(typename GridT::Ptr grid)
+			: m_grid(grid), m_accessor(m_grid->getConstAccessor())
+		{
+		}
+
+		GridAccessor(const GridAccessor&) = delete;
+		GridAccessor& operator=(const GridAccessor&) = delete;
+
+		ValueT get_value(const openvdb::Coord& ijk)
+		{
+			return accessor().getValue(ijk);
+		}
+
+		bool is_value_on(const openvdb::Coord& ijk)
+		{
+			return accessor().isValueOn(ijk);
+		}
+
+		// Trilinear samples at fractional index or world coordinates
+		ValueT sample_is(const openvdb::Vec3d& ijk)
+		{
+			return (ValueT)openvdb::tools::BoxSampler::sample(accessor(), ijk);
+		}
+
+		ValueT sample_ws(const openvdb::Vec3d& xyz)
+		{
+			return sample_is(m_grid->transform().worldToIndex(xyz));
+		}
+
+	private:
+		AccessorT& accessor()
+		{
+			// The cached nodes belong to one tree, so start over if the grid was given another
+			if (m_accessor.getTree() != &m_grid->constTree())
+				m_accessor = m_grid->getConstAccessor();
+
+			return m_accessor;
+		}
+
+		typename GridT::Ptr m_grid;
+		AccessorT m_accessor;
+	};
+}
+
+#endif
@@ -1,6 +1,9 @@
 #define GRIDBASE
 #ifdef GRIDBASE
 #include "GridBase.h"
+#include "QuantizedGrid.h"
+
+#include <tbb/parallel_sort.h>
 
 namespace DeepSight
 {
@@ -9,6 +12,7 @@ namespace DeepSight
 	GridBase::GridBase()
 	{
 		openvdb::initialize();
+		register_quantized_grids();
 	}
 
 	GridBase* GridBase::duplicate()
@@ -96,6 +100,76 @@ namespace DeepSight
 	}
 #pragma endregion Generic
 
+#pragma region Query_Order
+
+	// Spread the low 21 bits of v out to every third bit
+	static uint64_t spread_bits(uint64_t v)
+	{
+		v &= 0x1fffff;
+		v = (v | v << 32) & 0x1f00000000ffff;
+		v = (v | v << 16) & 0x1f0000ff0000ff;
+		v = (v | v << 8) & 0x100f00f00f00f00f;
+		v = (v | v << 4) & 0x10c30c30c30c30c3;
+		v = (v | v << 2) & 0x1249249249249249;
+		return v;
+	}
+
+	// Morton code of the leaf node holding ijk. Leaf coordinates are offset to be positive.
+	static uint64_t leaf_morton_code(const openvdb::Coord& ijk)
+	{
+		const int offset = 1 << 20;
+		return spread_bits((uint64_t)((ijk.x() >> 3) + offset))
+			| spread_bits((uint64_t)((ijk.y() >> 3) + offset)) << 1
+			| spread_bits((uint64_t)((ijk.z() >> 3) + offset)) << 2;
+	}
+
+	template<typename CoordFn>
+	static std::vector<uint32_t> sort_by_leaf(size_t num_coords, const CoordFn& coord)
+	{
+		// Ties are broken by position, so the order does not depend on the sort
+		std::vector<std::pair<uint64_t, uint32_t>> keys(num_coords);
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, num_coords, GridBase::BATCH_GRAIN_SIZE),
+			[&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t i = range.begin(); i < range.end(); ++i)
+					keys[i] = std::make_pair(leaf_morton_code(coord(i)), (uint32_t)i);
+			});
+
+		tbb::parallel_sort(keys.begin(), keys.end());
+
+		std::vector<uint32_t> order(num_coords);
+		for (size_t i = 0; i < num_coords; ++i)
+			order[i] = keys[i].second;
+
+		return order;
+	}
+
+	std::vector<uint32_t> morton_order(size_t num_coords, const int* coords)
+	{
+		return sort_by_leaf(num_coords, [coords](size_t i)
+			{
+				return openvdb::Coord(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]);
+			});
+	}
+
+	std::vector<uint32_t> morton_order(size_t num_coords, const double* coords, const openvdb::math::Transform& xform)
+	{
+		return sort_by_leaf(num_coords, [coords, &xform](size_t i)
+			{
+				return openvdb::Coord::floor(xform.worldToIndex(openvdb::Vec3d(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2])));
+			});
+	}
+
+	std::vector<uint32_t> morton_order(size_t num_coords, const float* coords, const openvdb::math::Transform& xform)
+	{
+		return sort_by_leaf(num_coords, [coords, &xform](size_t i)
+			{
+				return openvdb::Coord::floor(xform.worldToIndex(openvdb::Vec3d(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2])));
+			});
+	}
+
+#pragma endregion Query_Order
+
 
 
 
@@ -7,6 +7,9 @@
 #include <openvdb/openvdb.h>
 #include <openvdb/tools/Interpolation.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <string>
 #include <memory>
 
@@ -67,11 +70,18 @@ namespace DeepSight
 		template <typename GridT>
 		Eigen::Matrix<typename GridT::ValueType, 27, 1> get_neighbourhood(Eigen::Vector3i xyz);
 
+		// Coordinates per task of the batch lookups
+		static const size_t BATCH_GRAIN_SIZE = 1024;
+
+		// Values at num_coords index or world coordinates (3 per coordinate), read from coords
+		// and written to values as they are. Runs in parallel, with an accessor per task. With
+		// sorted, the coordinates are visited in morton_order, which keeps the accessors on
+		// their cached nodes for scattered queries. Values come back in the order of coords.
 		template <typename GridT>
-		std::vector<typename GridT::ValueType> get_values_is(std::vector<Eigen::Vector3i>& xyz);
+		void get_values_is(int num_coords, const int* coords, typename GridT::ValueType* values, bool sorted = false);
 
 		template <typename GridT>
-		std::vector<typename GridT::ValueType> get_values_ws(std::vector<Eigen::Vector3d>& xyz);
+		void get_values_ws(int num_coords, const double* coords, typename GridT::ValueType* values, bool sorted = false);
 
 		template<typename GridT>
 		void set_value(Eigen::Vector3i xyz, typename GridT::ValueType value);
@@ -102,6 +112,13 @@ namespace DeepSight
 	};
 
 
+	// Order in which to visit num_coords coordinates (3 per coordinate): by the Morton code of
+	// the 8^3 leaf node they fall in, so that consecutive ones mostly share a leaf or lie in
+	// neighbouring ones. World coordinates are taken to index space with xform.
+	std::vector<uint32_t> morton_order(size_t num_coords, const int* coords);
+	std::vector<uint32_t> morton_order(size_t num_coords, const double* coords, const openvdb::math::Transform& xform);
+	std::vector<uint32_t> morton_order(size_t num_coords, const float* coords, const openvdb::math::Transform& xform);
+
 	template<typename GridT>
 	void GridBase::initialize(typename GridT::ValueType background)
 	{
@@ -134,45 +151,48 @@ namespace DeepSight
 	}
 
 	template <typename GridT>
-	std::vector<typename GridT::ValueType> GridBase::get_values_is(std::vector<Eigen::Vector3i>& xyz)
+	void GridBase::get_values_is(int num_coords, const int* coords, typename GridT::ValueType* values, bool sorted)
 	{
-		std::vector<typename GridT::ValueType> values;
-
 		typename GridT::Ptr grid = openvdb::gridPtrCast<GridT>(m_grid);
-		typename GridT::Accessor accessor = grid->getAccessor();
 
-		for (auto iter = xyz.begin();
-			iter != xyz.end();
-			iter++)
-		{
-			values.push_back(
-				accessor.getValue(
-					openvdb::math::Coord(
-						iter->x(),
-						iter->y(),
-						iter->z()
-					)
-				)
-			);
-		}
-		return values;
+		std::vector<uint32_t> order;
+		if (sorted)
+			order = morton_order((size_t)std::max(num_coords, 0), coords);
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, (size_t)std::max(num_coords, 0), BATCH_GRAIN_SIZE),
+			[&](const tbb::blocked_range<size_t>& range)
+			{
+				typename GridT::ConstAccessor accessor = grid->getConstAccessor();
+
+				for (size_t j = range.begin(); j < range.end(); ++j)
+				{
+					size_t i = sorted ? order[j] : j;
+					values[i] = accessor.getValue(openvdb::Coord(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]));
+				}
+			});
 	}
 
 	template <typename GridT>
-	std::vector<typename GridT::ValueType> GridBase::get_values_ws(std::vector<Eigen::Vector3d>& xyz)
+	void GridBase::get_values_ws(int num_coords, const double* coords, typename GridT::ValueType* values, bool sorted)
 	{
-		std::vector<typename GridT::ValueType> values;
 		typename GridT::Ptr grid = openvdb::gridPtrCast<GridT>(m_grid);
 
-		openvdb::tools::GridSampler<GridT, openvdb::tools::BoxSampler> sampler(*grid);
+		std::vector<uint32_t> order;
+		if (sorted)
+			order = morton_order((size_t)std::max(num_coords, 0), coords, grid->transform());
 
-		for (auto iter = xyz.begin();
-			iter != xyz.end();
-			iter++)
-		{
-			values.push_back(sampler.wsSample(openvdb::Vec3R(iter->x(), iter->y(), iter->z())));
-		}
-		return values;
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, (size_t)std::max(num_coords, 0), BATCH_GRAIN_SIZE),
+			[&](const tbb::blocked_range<size_t>& range)
+			{
+				typename GridT::ConstAccessor accessor = grid->getConstAccessor();
+				openvdb::tools::GridSampler<typename GridT::ConstAccessor, openvdb::tools::BoxSampler> sampler(accessor, grid->transform());
+
+				for (size_t j = range.begin(); j < range.end(); ++j)
+				{
+					size_t i = sorted ? order[j] : j;
+					values[i] = sampler.wsSample(openvdb::Vec3R(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]));
+				}
+			});
 	}
 
 	template <typename GridT>
@@ -339,8 +359,8 @@ namespace DeepSight
 	template<> void GridBase::initialize<GridT>();\
 	template<> ValueT GridBase::get_value_is<GridT>(Eigen::Vector3i xyz);\
 	template<> ValueT GridBase::get_value_ws<GridT>(Eigen::Vector3d xyz);\
-	template<> std::vector<ValueT> GridBase::get_values_is<GridT>(std::vector<Eigen::Vector3i>& xyz);\
-	template<> std::vector<ValueT> GridBase::get_values_ws<GridT>(std::vector<Eigen::Vector3d>& xyz);\
+	template<> void GridBase::get_values_is<GridT>(int num_coords, const int* coords, ValueT* values, bool sorted);\
+	template<> void GridBase::get_values_ws<GridT>(int num_coords, const double* coords, ValueT* values, bool sorted);\
 	template<> ValueT GridBase::set_value<GridT>(Eigen::Vector3i xyz, ValueT value);\
 	template<> void GridBase::set_values<GridT>(std::vector<Eigen::Vector3i>& xyz, std::vector<ValueT> values);\
 	template<> std::vector<Eigen::Vector3i> GridBase::get_active_voxels<GridT>();\
@@ -1,6 +1,8 @@
 #include "GridBaseAPI.h"
 #include "GridBase.h"
 
+#include <iostream>
+
 namespace DeepSight
 {
 
@@ -33,6 +35,38 @@ namespace DeepSight
 		return grid;
 	}
 
+	GridBase* GridBase_CreateUInt8(float scale, float offset, float background)
+	{
+		return create_quantized_grid(QUANTIZED_UINT8, scale, offset, background);
+	}
+
+	GridBase* GridBase_CreateUInt16(float scale, float offset, float background)
+	{
+		return create_quantized_grid(QUANTIZED_UINT16, scale, offset, background);
+	}
+
+	GridBase* GridBase_CreateHalf(float background)
+	{
+		return create_quantized_grid(QUANTIZED_HALF, 1.0f, 0.0f, background);
+	}
+
+	GridBase* GridBase_Quantize(GridBase* ptr, int type, float min, float max)
+	{
+		return quantize_grid(ptr, type, min, max);
+	}
+
+	GridBase* GridBase_Dequantize(GridBase* ptr)
+	{
+		return dequantize_grid(ptr);
+	}
+
+	void GridBase_GetQuantization(GridBase* ptr, float* scale, float* offset)
+	{
+		Quantization quantization = Quantization::read(*ptr->m_grid);
+		*scale = quantization.scale;
+		*offset = quantization.offset;
+	}
+
 	GridBase* GridBase_Duplicate(GridBase* grid)
 	{
 		return grid->duplicate();
@@ -69,32 +103,22 @@ namespace DeepSight
 	// Multiple values
 	void FloatGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values)
 	{
-		std::vector<Eigen::Vector3d> vecs;
-
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3d(
-				coords[i * 3 + 0],
-				coords[i * 3 + 1],
-				coords[i * 3 + 2]
-			));
-		}
-
-		auto res = ptr->get_values_ws< openvdb::FloatGrid >(vecs);
-		std::copy(res.begin(), res.end(), values);
+		ptr->get_values_ws< openvdb::FloatGrid >(num_coords, coords, values);
 	}
 
 	void FloatGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values)
 	{
-		std::vector<Eigen::Vector3i> vecs;
+		ptr->get_values_is< openvdb::FloatGrid >(num_coords, coords, values);
+	}
 
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3i(&coords[i * 3]));
-		}
+	void FloatGrid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, float* values)
+	{
+		ptr->get_values_ws< openvdb::FloatGrid >(num_coords, coords, values, true);
+	}
 
-		auto res = ptr->get_values_is< openvdb::FloatGrid >(vecs);
-		std::copy(res.begin(), res.end(), values);
+	void FloatGrid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, float* values)
+	{
+		ptr->get_values_is< openvdb::FloatGrid >(num_coords, coords, values, true);
 	}
 
 	void FloatGrid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values)
@@ -171,32 +195,22 @@ namespace DeepSight
 	// Multiple values
 	void DoubleGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, double* values)
 	{
-		std::vector<Eigen::Vector3d> vecs;
-
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3d(
-				coords[i * 3 + 0],
-				coords[i * 3 + 1],
-				coords[i * 3 + 2]
-			));
-		}
-
-		auto res = ptr->get_values_ws< openvdb::DoubleGrid >(vecs);
-		std::copy(res.begin(), res.end(), values);
+		ptr->get_values_ws< openvdb::DoubleGrid >(num_coords, coords, values);
 	}
 
 	void DoubleGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, double* values)
 	{
-		std::vector<Eigen::Vector3i> vecs;
+		ptr->get_values_is< openvdb::DoubleGrid >(num_coords, coords, values);
+	}
 
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3i(&coords[i * 3]));
-		}
+	void DoubleGrid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, double* values)
+	{
+		ptr->get_values_ws< openvdb::DoubleGrid >(num_coords, coords, values, true);
+	}
 
-		auto res = ptr->get_values_is< openvdb::DoubleGrid >(vecs);
-		std::copy(res.begin(), res.end(), values);
+	void DoubleGrid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, double* values)
+	{
+		ptr->get_values_is< openvdb::DoubleGrid >(num_coords, coords, values, true);
 	}
 
 	void DoubleGrid_SetValues(GridBase* ptr, int num_coords, int* coords, double* values)
@@ -268,32 +282,22 @@ namespace DeepSight
 	// Multiple values
 	void Int32Grid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, int* values)
 	{
-		std::vector<Eigen::Vector3d> vecs;
-
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3d(
-				coords[i * 3 + 0],
-				coords[i * 3 + 1],
-				coords[i * 3 + 2]
-			));
-		}
-
-		auto res = ptr->get_values_ws< openvdb::Int32Grid >(vecs);
-		std::copy(res.begin(), res.end(), values);
+		ptr->get_values_ws< openvdb::Int32Grid >(num_coords, coords, values);
 	}
 
 	void Int32Grid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, int* values)
 	{
-		std::vector<Eigen::Vector3i> vecs;
+		ptr->get_values_is< openvdb::Int32Grid >(num_coords, coords, values);
+	}
 
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3i(&coords[i * 3]));
-		}
+	void Int32Grid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, int* values)
+	{
+		ptr->get_values_ws< openvdb::Int32Grid >(num_coords, coords, values, true);
+	}
 
-		auto res = ptr->get_values_is< openvdb::Int32Grid >(vecs);
-		std::copy(res.begin(), res.end(), values);
+	void Int32Grid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, int* values)
+	{
+		ptr->get_values_is< openvdb::Int32Grid >(num_coords, coords, values, true);
 	}
 
 	void Int32Grid_SetValues(GridBase* ptr, int num_coords, int* coords, int* values)
@@ -367,36 +371,22 @@ namespace DeepSight
 	// Multiple values
 	void Vec3fGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values)
 	{
-		std::vector<Eigen::Vector3d> vecs;
-
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3d(
-				coords[i * 3 + 0],
-				coords[i * 3 + 1],
-				coords[i * 3 + 2]
-			));
-		}
-
-		auto res = ptr->get_values_ws< openvdb::Vec3fGrid >(vecs);
-		auto values_ptr = reinterpret_cast<openvdb::Vec3f*>(values);
-
-		std::copy(res.begin(), res.end(), values_ptr);
+		ptr->get_values_ws< openvdb::Vec3fGrid >(num_coords, coords, reinterpret_cast<openvdb::Vec3f*>(values));
 	}
 
 	void Vec3fGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values)
 	{
-		std::vector<Eigen::Vector3i> vecs;
-
-		for (int i = 0; i < num_coords; ++i)
-		{
-			vecs.push_back(Eigen::Vector3i(&coords[i * 3]));
-		}
+		ptr->get_values_is< openvdb::Vec3fGrid >(num_coords, coords, reinterpret_cast<openvdb::Vec3f*>(values));
+	}
 
-		auto res = ptr->get_values_is< openvdb::Vec3fGrid >(vecs);
-		auto values_ptr = reinterpret_cast<openvdb::Vec3f*>(values);
+	void Vec3fGrid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, float* values)
+	{
+		ptr->get_values_ws< openvdb::Vec3fGrid >(num_coords, coords, reinterpret_cast<openvdb::Vec3f*>(values), true);
+	}
 
-		std::copy(res.begin(), res.end(), values_ptr);
+	void Vec3fGrid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, float* values)
+	{
+		ptr->get_values_is< openvdb::Vec3fGrid >(num_coords, coords, reinterpret_cast<openvdb::Vec3f*>(values), true);
 	}
 
 	void Vec3fGrid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values)
@@ -451,6 +441,130 @@ namespace DeepSight
 
 #pragma endregion Vec3fGrid
 
+#pragma region QuantizedGrids
+
+	// Values of quantized grids go in and out as float, and are encoded and decoded with
+	// the quantization of the grid.
+	template<typename GridT>
+	static void quantized_get_values_ws(GridBase* ptr, int num_coords, double* coords, float* values)
+	{
+		get_decoded_values_ws<GridT>(ptr, num_coords, coords, values);
+	}
+
+	template<typename GridT>
+	static void quantized_get_values_is(GridBase* ptr, int num_coords, int* coords, float* values)
+	{
+		get_decoded_values_is<GridT>(ptr, num_coords, coords, values);
+	}
+
+	template<typename GridT>
+	static void quantized_set_values(GridBase* ptr, int num_coords, int* coords, float* values)
+	{
+		Eigen::Vector3i* coord_ptr = reinterpret_cast<Eigen::Vector3i*>(coords);
+		std::vector<Eigen::Vector3i> vecs(coord_ptr, coord_ptr + num_coords);
+
+		set_encoded_values<GridT>(ptr, vecs, std::vector<float>(values, values + num_coords));
+	}
+
+	template<typename GridT>
+	static void quantized_get_active_voxels(GridBase* ptr, int* coords)
+	{
+		std::vector<Eigen::Vector3i> vecs = ptr->get_active_voxels<GridT>();
+		memcpy(coords, vecs.data(), sizeof(int) * 3 * vecs.size());
+	}
+
+	template<typename GridT>
+	static void quantized_set_active_states(GridBase* ptr, int num_coords, int* coord, int* state)
+	{
+		Eigen::Vector3i* coord_ptr = reinterpret_cast<Eigen::Vector3i*>(coord);
+		std::vector<Eigen::Vector3i> coord_vec(coord_ptr, coord_ptr + num_coords);
+		std::vector<bool> state_vec;
+
+		for (int i = 0; i < num_coords; ++i)
+			state_vec.push_back(state[i] != 0);
+
+		ptr->set_active_states<GridT>(coord_vec, state_vec);
+	}
+
+	float UInt8Grid_GetValueWs(GridBase* ptr, double x, double y, double z) { double xyz[] = { x, y, z }; float v; quantized_get_values_ws<UInt8Grid>(ptr, 1, xyz, &v); return v; }
+	float UInt8Grid_GetValueIs(GridBase* ptr, int x, int y, int z) { int xyz[] = { x, y, z }; float v; quantized_get_values_is<UInt8Grid>(ptr, 1, xyz, &v); return v; }
+	void UInt8Grid_SetValue(GridBase* ptr, int x, int y, int z, float v) { int xyz[] = { x, y, z }; quantized_set_values<UInt8Grid>(ptr, 1, xyz, &v); }
+
+	void UInt8Grid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values) { quantized_get_values_ws<UInt8Grid>(ptr, num_coords, coords, values); }
+	void UInt8Grid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values) { quantized_get_values_is<UInt8Grid>(ptr, num_coords, coords, values); }
+	void UInt8Grid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values) { quantized_set_values<UInt8Grid>(ptr, num_coords, coords, values); }
+
+	void UInt8Grid_GetActiveVoxels(GridBase* ptr, int* coords) { quantized_get_active_voxels<UInt8Grid>(ptr, coords); }
+	void UInt8Grid_SetActiveState(GridBase* ptr, int* coord, int state) { ptr->set_active_state<UInt8Grid>(Eigen::Vector3i(coord), state != 0); }
+	void UInt8Grid_SetActiveStates(GridBase* ptr, int num_coords, int* coord, int* state) { quantized_set_active_states<UInt8Grid>(ptr, num_coords, coord, state); }
+
+	float UInt16Grid_GetValueWs(GridBase* ptr, double x, double y, double z) { double xyz[] = { x, y, z }; float v; quantized_get_values_ws<UInt16Grid>(ptr, 1, xyz, &v); return v; }
+	float UInt16Grid_GetValueIs(GridBase* ptr, int x, int y, int z) { int xyz[] = { x, y, z }; float v; quantized_get_values_is<UInt16Grid>(ptr, 1, xyz, &v); return v; }
+	void UInt16Grid_SetValue(GridBase* ptr, int x, int y, int z, float v) { int xyz[] = { x, y, z }; quantized_set_values<UInt16Grid>(ptr, 1, xyz, &v); }
+
+	void UInt16Grid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values) { quantized_get_values_ws<UInt16Grid>(ptr, num_coords, coords, values); }
+	void UInt16Grid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values) { quantized_get_values_is<UInt16Grid>(ptr, num_coords, coords, values); }
+	void UInt16Grid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values) { quantized_set_values<UInt16Grid>(ptr, num_coords, coords, values); }
+
+	void UInt16Grid_GetActiveVoxels(GridBase* ptr, int* coords) { quantized_get_active_voxels<UInt16Grid>(ptr, coords); }
+	void UInt16Grid_SetActiveState(GridBase* ptr, int* coord, int state) { ptr->set_active_state<UInt16Grid>(Eigen::Vector3i(coord), state != 0); }
+	void UInt16Grid_SetActiveStates(GridBase* ptr, int num_coords, int* coord, int* state) { quantized_set_active_states<UInt16Grid>(ptr, num_coords, coord, state); }
+
+	float HalfGrid_GetValueWs(GridBase* ptr, double x, double y, double z) { double xyz[] = { x, y, z }; float v; quantized_get_values_ws<HalfGrid>(ptr, 1, xyz, &v); return v; }
+	float HalfGrid_GetValueIs(GridBase* ptr, int x, int y, int z) { int xyz[] = { x, y, z }; float v; quantized_get_values_is<HalfGrid>(ptr, 1, xyz, &v); return v; }
+	void HalfGrid_SetValue(GridBase* ptr, int x, int y, int z, float v) { int xyz[] = { x, y, z }; quantized_set_values<HalfGrid>(ptr, 1, xyz, &v); }
+
+	void HalfGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values) { quantized_get_values_ws<HalfGrid>(ptr, num_coords, coords, values); }
+	void HalfGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values) { quantized_get_values_is<HalfGrid>(ptr, num_coords, coords, values); }
+	void HalfGrid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values) { quantized_set_values<HalfGrid>(ptr, num_coords, coords, values); }
+
+	void HalfGrid_GetActiveVoxels(GridBase* ptr, int* coords) { quantized_get_active_voxels<HalfGrid>(ptr, coords); }
+	void HalfGrid_SetActiveState(GridBase* ptr, int* coord, int state) { ptr->set_active_state<HalfGrid>(Eigen::Vector3i(coord), state != 0); }
+	void HalfGrid_SetActiveStates(GridBase* ptr, int num_coords, int* coord, int* state) { quantized_set_active_states<HalfGrid>(ptr, num_coords, coord, state); }
+
+#pragma endregion QuantizedGrids
+
+#pragma region GridAccessor
+
+	template<typename GridT>
+	static GridAccessorBase* create_accessor(GridBase* ptr)
+	{
+		typename GridT::Ptr grid = openvdb::gridPtrCast<GridT>(ptr->m_grid);
+		if (grid == nullptr)
+		{
+			std::cerr << "Grid '" << ptr->m_grid->getName() << "' is not of type " << GridT::gridType() << std::endl;
+			return nullptr;
+		}
+
+		return new GridAccessor<GridT>(grid);
+	}
+
+	GridAccessorBase* FloatGrid_CreateAccessor(GridBase* ptr) { return create_accessor<openvdb::FloatGrid>(ptr); }
+	GridAccessorBase* DoubleGrid_CreateAccessor(GridBase* ptr) { return create_accessor<openvdb::DoubleGrid>(ptr); }
+	GridAccessorBase* Int32Grid_CreateAccessor(GridBase* ptr) { return create_accessor<openvdb::Int32Grid>(ptr); }
+
+	void GridAccessor_Delete(GridAccessorBase* ptr)
+	{
+		delete ptr;
+	}
+
+	float FloatAccessor_GetValue(GridAccessorBase* ptr, int x, int y, int z) { return static_cast<GridAccessor<openvdb::FloatGrid>*>(ptr)->get_value(openvdb::Coord(x, y, z)); }
+	int FloatAccessor_GetActiveState(GridAccessorBase* ptr, int x, int y, int z) { return static_cast<GridAccessor<openvdb::FloatGrid>*>(ptr)->is_value_on(openvdb::Coord(x, y, z)) ? 1 : 0; }
+	float FloatAccessor_SampleIs(GridAccessorBase* ptr, double x, double y, double z) { return static_cast<GridAccessor<openvdb::FloatGrid>*>(ptr)->sample_is(openvdb::Vec3d(x, y, z)); }
+	float FloatAccessor_SampleWs(GridAccessorBase* ptr, double x, double y, double z) { return static_cast<GridAccessor<openvdb::FloatGrid>*>(ptr)->sample_ws(openvdb::Vec3d(x, y, z)); }
+
+	double DoubleAccessor_GetValue(GridAccessorBase* ptr, int x, int y, int z) { return static_cast<GridAccessor<openvdb::DoubleGrid>*>(ptr)->get_value(openvdb::Coord(x, y, z)); }
+	int DoubleAccessor_GetActiveState(GridAccessorBase* ptr, int x, int y, int z) { return static_cast<GridAccessor<openvdb::DoubleGrid>*>(ptr)->is_value_on(openvdb::Coord(x, y, z)) ? 1 : 0; }
+	double DoubleAccessor_SampleIs(GridAccessorBase* ptr, double x, double y, double z) { return static_cast<GridAccessor<openvdb::DoubleGrid>*>(ptr)->sample_is(openvdb::Vec3d(x, y, z)); }
+	double DoubleAccessor_SampleWs(GridAccessorBase* ptr, double x, double y, double z) { return static_cast<GridAccessor<openvdb::DoubleGrid>*>(ptr)->sample_ws(openvdb::Vec3d(x, y, z)); }
+
+	int Int32Accessor_GetValue(GridAccessorBase* ptr, int x, int y, int z) { return static_cast<GridAccessor<openvdb::Int32Grid>*>(ptr)->get_value(openvdb::Coord(x, y, z)); }
+	int Int32Accessor_GetActiveState(GridAccessorBase* ptr, int x, int y, int z) { return static_cast<GridAccessor<openvdb::Int32Grid>*>(ptr)->is_value_on(openvdb::Coord(x, y, z)) ? 1 : 0; }
+	int Int32Accessor_SampleIs(GridAccessorBase* ptr, double x, double y, double z) { return static_cast<GridAccessor<openvdb::Int32Grid>*>(ptr)->sample_is(openvdb::Vec3d(x, y, z)); }
+	int Int32Accessor_SampleWs(GridAccessorBase* ptr, double x, double y, double z) { return static_cast<GridAccessor<openvdb::Int32Grid>*>(ptr)->sample_ws(openvdb::Vec3d(x, y, z)); }
+
+#pragma endregion GridAccessor
+
 #pragma endregion Get_Set
 
 #pragma region Generic
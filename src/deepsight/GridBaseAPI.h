@@ -2,6 +2,8 @@
 #define GRIDBASE_API_H
 
 #include "GridBase.h"
+#include "QuantizedGrid.h"
+#include "GridAccessor.h"
 
 namespace DeepSight
 {
@@ -13,6 +15,19 @@ namespace DeepSight
 		DEEPSIGHT_EXPORT GridBase* GridBase_CreateInt32(int background);
 		DEEPSIGHT_EXPORT GridBase* GridBase_CreateVec3f(float* background);
 
+		// Quantized grids store values as offset + scale * stored value, see QuantizedGrid.h.
+		// Half grids ignore scale and offset.
+		DEEPSIGHT_EXPORT GridBase* GridBase_CreateUInt8(float scale, float offset, float background);
+		DEEPSIGHT_EXPORT GridBase* GridBase_CreateUInt16(float scale, float offset, float background);
+		DEEPSIGHT_EXPORT GridBase* GridBase_CreateHalf(float background);
+
+		// Quantize a float grid into a new grid of QuantizedType type. Values are clamped to
+		// [min, max], or to the range of the grid if min >= max. Returns nullptr for other grids.
+		DEEPSIGHT_EXPORT GridBase* GridBase_Quantize(GridBase* ptr, int type, float min, float max);
+		// Decode a quantized grid into a new float grid. Returns nullptr for other grids.
+		DEEPSIGHT_EXPORT GridBase* GridBase_Dequantize(GridBase* ptr);
+		DEEPSIGHT_EXPORT void GridBase_GetQuantization(GridBase* ptr, float* scale, float* offset);
+
 		DEEPSIGHT_EXPORT GridBase* GridBase_Duplicate(GridBase* grid);
 
 		DEEPSIGHT_EXPORT void GridBase_Delete(GridBase* grid);
@@ -43,6 +58,10 @@ namespace DeepSight
 
 		DEEPSIGHT_EXPORT void FloatGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values);
 		DEEPSIGHT_EXPORT void FloatGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values);
+		// Same as GetValuesWs and GetValuesIs, but visiting the coordinates in Morton order of their
+		// leaf nodes, which is faster for scattered coordinates. Values come back in the given order.
+		DEEPSIGHT_EXPORT void FloatGrid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, float* values);
+		DEEPSIGHT_EXPORT void FloatGrid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, float* values);
 		DEEPSIGHT_EXPORT void FloatGrid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values);
 
 		DEEPSIGHT_EXPORT void FloatGrid_GetActiveVoxels(GridBase* ptr, int* coords);
@@ -63,6 +82,8 @@ namespace DeepSight
 
 		DEEPSIGHT_EXPORT void DoubleGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, double* values);
 		DEEPSIGHT_EXPORT void DoubleGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, double* values);
+		DEEPSIGHT_EXPORT void DoubleGrid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, double* values);
+		DEEPSIGHT_EXPORT void DoubleGrid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, double* values);
 		DEEPSIGHT_EXPORT void DoubleGrid_SetValues(GridBase* ptr, int num_coords, int* coords, double* values);
 
 		DEEPSIGHT_EXPORT void DoubleGrid_GetActiveVoxels(GridBase* ptr, int* coords);
@@ -82,6 +103,8 @@ namespace DeepSight
 
 		DEEPSIGHT_EXPORT void Int32Grid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, int* values);
 		DEEPSIGHT_EXPORT void Int32Grid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, int* values);
+		DEEPSIGHT_EXPORT void Int32Grid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, int* values);
+		DEEPSIGHT_EXPORT void Int32Grid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, int* values);
 		DEEPSIGHT_EXPORT void Int32Grid_SetValues(GridBase* ptr, int num_coords, int* coords, int* values);
 
 		DEEPSIGHT_EXPORT void Int32Grid_GetActiveVoxels(GridBase* ptr, int* coords);
@@ -100,6 +123,8 @@ namespace DeepSight
 
 		DEEPSIGHT_EXPORT void Vec3fGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values);
 		DEEPSIGHT_EXPORT void Vec3fGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values);
+		DEEPSIGHT_EXPORT void Vec3fGrid_GetValuesWsSorted(GridBase* ptr, int num_coords, double* coords, float* values);
+		DEEPSIGHT_EXPORT void Vec3fGrid_GetValuesIsSorted(GridBase* ptr, int num_coords, int* coords, float* values);
 		DEEPSIGHT_EXPORT void Vec3fGrid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values);
 
 		DEEPSIGHT_EXPORT void Vec3fGrid_GetActiveVoxels(GridBase* ptr, int* coords);
@@ -110,6 +135,80 @@ namespace DeepSight
 
 #pragma endregion Vec3fGrid
 
+#pragma region UInt8Grid
+
+		DEEPSIGHT_EXPORT float UInt8Grid_GetValueWs(GridBase* ptr, double x, double y, double z);
+		DEEPSIGHT_EXPORT float UInt8Grid_GetValueIs(GridBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT void UInt8Grid_SetValue(GridBase* ptr, int x, int y, int z, float v);
+
+		DEEPSIGHT_EXPORT void UInt8Grid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values);
+		DEEPSIGHT_EXPORT void UInt8Grid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values);
+		DEEPSIGHT_EXPORT void UInt8Grid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values);
+
+		DEEPSIGHT_EXPORT void UInt8Grid_GetActiveVoxels(GridBase* ptr, int* coords);
+		DEEPSIGHT_EXPORT void UInt8Grid_SetActiveState(GridBase* ptr, int* coord, int state);
+		DEEPSIGHT_EXPORT void UInt8Grid_SetActiveStates(GridBase* ptr, int num_coords, int* coord, int* state);
+
+#pragma endregion UInt8Grid
+
+#pragma region UInt16Grid
+
+		DEEPSIGHT_EXPORT float UInt16Grid_GetValueWs(GridBase* ptr, double x, double y, double z);
+		DEEPSIGHT_EXPORT float UInt16Grid_GetValueIs(GridBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT void UInt16Grid_SetValue(GridBase* ptr, int x, int y, int z, float v);
+
+		DEEPSIGHT_EXPORT void UInt16Grid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values);
+		DEEPSIGHT_EXPORT void UInt16Grid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values);
+		DEEPSIGHT_EXPORT void UInt16Grid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values);
+
+		DEEPSIGHT_EXPORT void UInt16Grid_GetActiveVoxels(GridBase* ptr, int* coords);
+		DEEPSIGHT_EXPORT void UInt16Grid_SetActiveState(GridBase* ptr, int* coord, int state);
+		DEEPSIGHT_EXPORT void UInt16Grid_SetActiveStates(GridBase* ptr, int num_coords, int* coord, int* state);
+
+#pragma endregion UInt16Grid
+
+#pragma region HalfGrid
+
+		DEEPSIGHT_EXPORT float HalfGrid_GetValueWs(GridBase* ptr, double x, double y, double z);
+		DEEPSIGHT_EXPORT float HalfGrid_GetValueIs(GridBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT void HalfGrid_SetValue(GridBase* ptr, int x, int y, int z, float v);
+
+		DEEPSIGHT_EXPORT void HalfGrid_GetValuesWs(GridBase* ptr, int num_coords, double* coords, float* values);
+		DEEPSIGHT_EXPORT void HalfGrid_GetValuesIs(GridBase* ptr, int num_coords, int* coords, float* values);
+		DEEPSIGHT_EXPORT void HalfGrid_SetValues(GridBase* ptr, int num_coords, int* coords, float* values);
+
+		DEEPSIGHT_EXPORT void HalfGrid_GetActiveVoxels(GridBase* ptr, int* coords);
+		DEEPSIGHT_EXPORT void HalfGrid_SetActiveState(GridBase* ptr, int* coord, int state);
+		DEEPSIGHT_EXPORT void HalfGrid_SetActiveStates(GridBase* ptr, int num_coords, int* coord, int* state);
+
+#pragma endregion HalfGrid
+
+#pragma region GridAccessor
+
+		// Accessors that keep their cached nodes across calls (see GridAccessor.h), for many
+		// single-point queries in a row. Freed with GridAccessor_Delete.
+		DEEPSIGHT_EXPORT GridAccessorBase* FloatGrid_CreateAccessor(GridBase* ptr);
+		DEEPSIGHT_EXPORT GridAccessorBase* DoubleGrid_CreateAccessor(GridBase* ptr);
+		DEEPSIGHT_EXPORT GridAccessorBase* Int32Grid_CreateAccessor(GridBase* ptr);
+		DEEPSIGHT_EXPORT void GridAccessor_Delete(GridAccessorBase* ptr);
+
+		DEEPSIGHT_EXPORT float FloatAccessor_GetValue(GridAccessorBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT int FloatAccessor_GetActiveState(GridAccessorBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT float FloatAccessor_SampleIs(GridAccessorBase* ptr, double x, double y, double z);
+		DEEPSIGHT_EXPORT float FloatAccessor_SampleWs(GridAccessorBase* ptr, double x, double y, double z);
+
+		DEEPSIGHT_EXPORT double DoubleAccessor_GetValue(GridAccessorBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT int DoubleAccessor_GetActiveState(GridAccessorBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT double DoubleAccessor_SampleIs(GridAccessorBase* ptr, double x, double y, double z);
+		DEEPSIGHT_EXPORT double DoubleAccessor_SampleWs(GridAccessorBase* ptr, double x, double y, double z);
+
+		DEEPSIGHT_EXPORT int Int32Accessor_GetValue(GridAccessorBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT int Int32Accessor_GetActiveState(GridAccessorBase* ptr, int x, int y, int z);
+		DEEPSIGHT_EXPORT int Int32Accessor_SampleIs(GridAccessorBase* ptr, double x, double y, double z);
+		DEEPSIGHT_EXPORT int Int32Accessor_SampleWs(GridAccessorBase* ptr, double x, double y, double z);
+
+#pragma endregion GridAccessor
+
 #endif
 
 #ifdef __cplusplus
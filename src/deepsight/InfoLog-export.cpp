@@ -2,6 +2,8 @@
 #include "InfoLog.h"
 #include "ReadWrite.h"
 
+#include <algorithm>
+
 namespace RawLam
 {
 
@@ -53,4 +55,157 @@ namespace RawLam
 		delete[] ptr;
 		ptr = NULL;
 	}
+
+	// The C API hands out the knot array as it is
+	static_assert(sizeof(knot) == 11 * sizeof(float), "knot records are expected to be 44 bytes");
+
+	static void get_outlines(const OutlineSet& outlines, int& n_outlines, const uint64_t*& offsets, long long& n_points, const float*& points)
+	{
+		n_outlines = (int)outlines.size();
+		offsets = outlines.offsets.data();
+		n_points = (long long)outlines.points.size();
+		points = reinterpret_cast<const float*>(outlines.points.data());
+	}
+
+	InfoLog* InfoLog_Open(const char* filepath)
+	{
+		RawLam::InfoLog::Ptr ilog = DeepSight::load_infolog(filepath, false);
+		if (!ilog)
+			return nullptr;
+
+		return new InfoLog(std::move(*ilog));
+	}
+
+	void InfoLog_Delete(InfoLog* ptr)
+	{
+		delete ptr;
+	}
+
+	void InfoLog_GetPith(InfoLog* ptr, int& n_pith, const float*& pith)
+	{
+		n_pith = (int)ptr->pith.size();
+		pith = reinterpret_cast<const float*>(ptr->pith.data());
+	}
+
+	void InfoLog_GetKnots(InfoLog* ptr, int& n_knots, const knot*& knots)
+	{
+		n_knots = (int)ptr->knots.size();
+		knots = ptr->knots.data();
+	}
+
+	void InfoLog_GetBorder(InfoLog* ptr, int& n_outlines, const uint64_t*& offsets, long long& n_points, const float*& points)
+	{
+		get_outlines(ptr->border, n_outlines, offsets, n_points, points);
+	}
+
+	void InfoLog_GetSapwood(InfoLog* ptr, int& n_outlines, const uint64_t*& offsets, long long& n_points, const float*& points)
+	{
+		get_outlines(ptr->sapwood, n_outlines, offsets, n_points, points);
+	}
+
+	static std::vector<Eigen::Vector3f> to_points(const float* data, int count)
+	{
+		std::vector<Eigen::Vector3f> points(count);
+		for (int i = 0; i < count; ++i)
+			points[i] = Eigen::Vector3f(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]);
+
+		return points;
+	}
+
+	static void copy_hits(const std::vector<int>& offsets_in, const std::vector<int>& hits_in, int*& offsets, int& n_hits, int*& hits)
+	{
+		offsets = new int[offsets_in.size()];
+		std::copy(offsets_in.begin(), offsets_in.end(), offsets);
+
+		n_hits = (int)hits_in.size();
+		hits = new int[hits_in.size()];
+		std::copy(hits_in.begin(), hits_in.end(), hits);
+	}
+
+	KnotIndex* KnotIndex_Create(InfoLog* ptr)
+	{
+		return new KnotIndex(ptr->knots);
+	}
+
+	void KnotIndex_Delete(KnotIndex* ptr)
+	{
+		delete ptr;
+	}
+
+	void KnotIndex_QueryBoxes(KnotIndex* ptr, int num_queries, const float* min, const float* max, int*& offsets, int& n_hits, int*& hits)
+	{
+		std::vector<int> offsets_out, hits_out;
+		ptr->query_boxes(to_points(min, num_queries), to_points(max, num_queries), offsets_out, hits_out);
+
+		copy_hits(offsets_out, hits_out, offsets, n_hits, hits);
+	}
+
+	void KnotIndex_QuerySegments(KnotIndex* ptr, int num_queries, const float* a, const float* b, int*& offsets, int& n_hits, int*& hits)
+	{
+		std::vector<int> offsets_out, hits_out;
+		ptr->query_segments(to_points(a, num_queries), to_points(b, num_queries), offsets_out, hits_out);
+
+		copy_hits(offsets_out, hits_out, offsets, n_hits, hits);
+	}
+
+	void KnotIndex_free(int*& ptr)
+	{
+		delete[] ptr;
+		ptr = NULL;
+	}
+
+	void KnotIndex_Nearest(KnotIndex* ptr, int num_points, const float* points, float max_distance, int* knots, float* distances)
+	{
+		std::vector<int> knots_out;
+		std::vector<float> distances_out;
+		ptr->nearest(to_points(points, num_points), knots_out, distances_out, max_distance);
+
+		std::copy(knots_out.begin(), knots_out.end(), knots);
+		std::copy(distances_out.begin(), distances_out.end(), distances);
+	}
+
+	// The C API hands out the summaries as they are
+	static_assert(sizeof(InfoLogSummary) == 24, "summary records are expected to be 24 bytes");
+
+	InfoLogCatalog* InfoLogCatalog_Create(double z_spacing)
+	{
+		return new InfoLogCatalog(z_spacing);
+	}
+
+	void InfoLogCatalog_Delete(InfoLogCatalog* ptr)
+	{
+		delete ptr;
+	}
+
+	int InfoLogCatalog_Load(InfoLogCatalog* ptr, int num_paths, const char** paths, int use_cache)
+	{
+		return (int)ptr->load(std::vector<std::string>(paths, paths + num_paths), use_cache != 0);
+	}
+
+	int InfoLogCatalog_Find(InfoLogCatalog* ptr, const char* name)
+	{
+		return ptr->find(name);
+	}
+
+	const char* InfoLogCatalog_GetName(InfoLogCatalog* ptr, int i)
+	{
+		if (i < 0 || i >= (int)ptr->size())
+			return nullptr;
+
+		return ptr->name(i).c_str();
+	}
+
+	void InfoLogCatalog_GetSummaries(InfoLogCatalog* ptr, int& n_logs, const InfoLogSummary*& summaries)
+	{
+		n_logs = (int)ptr->size();
+		summaries = ptr->summaries().data();
+	}
+
+	InfoLog* InfoLogCatalog_GetLog(InfoLogCatalog* ptr, int i)
+	{
+		if (i < 0 || i >= (int)ptr->size())
+			return nullptr;
+
+		return ptr->log(i).get();
+	}
 }
\ No newline at end of file
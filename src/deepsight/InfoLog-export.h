@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "InfoLog.h"
+#include "KnotIndex.h"
+#include "InfoLogCatalog.h"
 
 
 namespace RawLam
@@ -18,6 +20,60 @@ extern "C" {
 	DEEPSIGHT_EXPORT void InfoLog_Load(const char* filepath, int& n_pith, float*& pith, int& n_knots, float*& knots);
 	DEEPSIGHT_EXPORT void InfoLog_free(float*& ptr);
 
+	// Load an InfoLog and keep it, so that its arrays can be read in place through the
+	// pointers below. These stay valid until the InfoLog is freed with InfoLog_Delete.
+	// Returns nullptr if the InfoLog could not be loaded.
+	DEEPSIGHT_EXPORT InfoLog* InfoLog_Open(const char* filepath);
+	DEEPSIGHT_EXPORT void InfoLog_Delete(InfoLog* ptr);
+
+	// n_pith (x, y) pairs of floats.
+	DEEPSIGHT_EXPORT void InfoLog_GetPith(InfoLog* ptr, int& n_pith, const float*& pith);
+
+	// n_knots records of 44 bytes, laid out as RawLam::knot: radius, length and volume (float),
+	// index and dead_knot_border (int32), start and end (3 floats each).
+	DEEPSIGHT_EXPORT void InfoLog_GetKnots(InfoLog* ptr, int& n_knots, const knot*& knots);
+
+	// n_outlines + 1 offsets into n_points (x, y) pairs of floats. Outline i is made of the
+	// points offsets[i] up to, but not including, offsets[i + 1].
+	DEEPSIGHT_EXPORT void InfoLog_GetBorder(InfoLog* ptr, int& n_outlines, const uint64_t*& offsets, long long& n_points, const float*& points);
+	DEEPSIGHT_EXPORT void InfoLog_GetSapwood(InfoLog* ptr, int& n_outlines, const uint64_t*& offsets, long long& n_points, const float*& points);
+
+	// Spatial index over the knots of an InfoLog (see KnotIndex.h). It keeps its own copy of
+	// the knots, and is freed with KnotIndex_Delete.
+	DEEPSIGHT_EXPORT KnotIndex* KnotIndex_Create(InfoLog* ptr);
+	DEEPSIGHT_EXPORT void KnotIndex_Delete(KnotIndex* ptr);
+
+	// Knots overlapping num_queries boxes (min and max, 3 floats each) or segments (a to b). The
+	// knots of query i are hits[offsets[i]] up to hits[offsets[i + 1]]. offsets and hits are
+	// allocated here and freed with KnotIndex_free.
+	DEEPSIGHT_EXPORT void KnotIndex_QueryBoxes(KnotIndex* ptr, int num_queries, const float* min, const float* max, int*& offsets, int& n_hits, int*& hits);
+	DEEPSIGHT_EXPORT void KnotIndex_QuerySegments(KnotIndex* ptr, int num_queries, const float* a, const float* b, int*& offsets, int& n_hits, int*& hits);
+	DEEPSIGHT_EXPORT void KnotIndex_free(int*& ptr);
+
+	// Nearest knot to each of num_points points, or -1 if none is within max_distance, and the
+	// distance to its surface. knots and distances are allocated by the caller.
+	DEEPSIGHT_EXPORT void KnotIndex_Nearest(KnotIndex* ptr, int num_points, const float* points, float max_distance, int* knots, float* distances);
+
+	// Catalog of InfoLogs loaded in parallel and kept by the name of their file (see InfoLogCatalog.h).
+	// Pith lengths of the summaries take slices to be z_spacing apart.
+	DEEPSIGHT_EXPORT InfoLogCatalog* InfoLogCatalog_Create(double z_spacing);
+	DEEPSIGHT_EXPORT void InfoLogCatalog_Delete(InfoLogCatalog* ptr);
+
+	// Load num_paths InfoLogs in parallel, through the InfoLog cache if use_cache. Returns the number loaded.
+	DEEPSIGHT_EXPORT int InfoLogCatalog_Load(InfoLogCatalog* ptr, int num_paths, const char** paths, int use_cache);
+
+	// Position of the log called name, or -1, and the name of the log at position i.
+	DEEPSIGHT_EXPORT int InfoLogCatalog_Find(InfoLogCatalog* ptr, const char* name);
+	DEEPSIGHT_EXPORT const char* InfoLogCatalog_GetName(InfoLogCatalog* ptr, int i);
+
+	// n_logs records of 24 bytes, laid out as RawLam::InfoLogSummary: num_knots and num_slices
+	// (int32), knot_volume and pith_length (double). Valid until the next load.
+	DEEPSIGHT_EXPORT void InfoLogCatalog_GetSummaries(InfoLogCatalog* ptr, int& n_logs, const InfoLogSummary*& summaries);
+
+	// The log at position i, to be read with the InfoLog_Get functions. It belongs to the catalog
+	// and stays valid until it is replaced by a later load or the catalog is deleted.
+	DEEPSIGHT_EXPORT InfoLog* InfoLogCatalog_GetLog(InfoLogCatalog* ptr, int i);
+
 #ifdef __cplusplus
 }
 #endif
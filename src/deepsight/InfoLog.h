@@ -5,6 +5,9 @@
 #include <cmath>
 #include <Eigen/Core>
 #include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
 
 
 namespace RawLam
@@ -22,6 +25,31 @@ namespace RawLam
 		std::string to_string();
 	};
 
+	// Outlines of all slices in one contiguous array of points. The points of outline i
+	// are points[offsets[i]] up to, but not including, points[offsets[i + 1]].
+	struct OutlineSet
+	{
+		std::vector<Eigen::Vector2f> points;
+		std::vector<uint64_t> offsets;
+
+		OutlineSet() : offsets(1, 0) {}
+
+		size_t size() const { return offsets.size() - 1; }
+		bool empty() const { return size() == 0; }
+
+		size_t outline_size(size_t i) const { return (size_t)(offsets[i + 1] - offsets[i]); }
+		const Eigen::Vector2f* outline(size_t i) const { return points.data() + offsets[i]; }
+
+		// Close the outline made of the points added since the last one
+		void end_outline() { offsets.push_back(points.size()); }
+
+		void clear()
+		{
+			points.clear();
+			offsets.assign(1, 0);
+		}
+	};
+
 	class InfoLog
 	{
 	public:
@@ -33,8 +61,8 @@ namespace RawLam
 		InfoLog(InfoLog&&) = default;
 
 		std::vector<Eigen::Vector2f> pith;
-		std::vector<std::vector<Eigen::Vector2f>> sapwood;
-		std::vector< std::vector<Eigen::Vector2f>> border;
+		OutlineSet sapwood;
+		OutlineSet border;
 		std::vector<knot> knots;
 
 		std::string name;
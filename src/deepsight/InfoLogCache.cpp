@@ -0,0 +1,198 @@
+#include "InfoLogCache.h"
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace DeepSight
+{
+	static bool source_stamp(const std::string path, uint64_t& size, int64_t& time)
+	{
+		std::error_code ec;
+
+		size = (uint64_t)std::filesystem::file_size(path, ec);
+		if (ec) return false;
+
+		auto write_time = std::filesystem::last_write_time(path, ec);
+		if (ec) return false;
+
+		time = (int64_t)write_time.time_since_epoch().count();
+		return true;
+	}
+
+	// Size of a cache file with the counts of header, or 0 if the counts cannot be right
+	static uint64_t cache_size(const InfoLogCacheHeader& header, uint64_t limit)
+	{
+		const uint64_t counts[] = { header.num_pith, header.num_knots, header.num_border,
+			header.num_border_points, header.num_sapwood, header.num_sapwood_points };
+
+		// Rules out counts that would overflow the sum below
+		for (uint64_t n : counts)
+			if (n > limit) return 0;
+
+		return sizeof(InfoLogCacheHeader)
+			+ (header.num_border + 1 + header.num_sapwood + 1) * sizeof(uint64_t)
+			+ header.num_pith * 2 * sizeof(float)
+			+ header.num_knots * sizeof(InfoLogCacheKnot)
+			+ (header.num_border_points + header.num_sapwood_points) * 2 * sizeof(float);
+	}
+
+	std::string infolog_cache_path(const std::string path)
+	{
+		return path + ".dscache";
+	}
+
+#pragma region Cache_read
+
+	// Sequential reader of the mapped cache
+	struct CacheCursor
+	{
+		const uint8_t* ptr;
+
+		template<typename T>
+		void read(T* dst, uint64_t count)
+		{
+			std::memcpy(dst, ptr, count * sizeof(T));
+			ptr += count * sizeof(T);
+		}
+	};
+
+	static bool valid_offsets(const std::vector<uint64_t>& offsets, uint64_t num_points)
+	{
+		if (offsets.front() != 0 || offsets.back() != num_points)
+			return false;
+
+		for (size_t i = 1; i < offsets.size(); ++i)
+			if (offsets[i] < offsets[i - 1])
+				return false;
+
+		return true;
+	}
+
+	// Outline sets are stored as they are kept in memory, so they are read with one copy each
+	static void read_points(CacheCursor& cursor, RawLam::OutlineSet& outlines)
+	{
+		outlines.points.resize(outlines.offsets.back());
+		cursor.read(reinterpret_cast<float*>(outlines.points.data()), outlines.points.size() * 2);
+	}
+
+	RawLam::InfoLog::Ptr read_infolog_cache(const std::string path)
+	{
+		uint64_t source_size;
+		int64_t source_time;
+		if (!source_stamp(path, source_size, source_time))
+			return nullptr;
+
+		MappedFile file;
+		if (!file.open(infolog_cache_path(path)) || file.size() < sizeof(InfoLogCacheHeader))
+			return nullptr;
+
+		InfoLogCacheHeader header;
+		std::memcpy(&header, file.data(), sizeof(InfoLogCacheHeader));
+
+		if (header.magic != InfoLogCacheHeader::MAGIC || header.version != InfoLogCacheHeader::VERSION)
+			return nullptr;
+
+		if (header.source_size != source_size || header.source_time != source_time)
+			return nullptr;
+
+		if (cache_size(header, file.size()) != file.size())
+			return nullptr;
+
+		CacheCursor cursor{ file.data() + sizeof(InfoLogCacheHeader) };
+
+		auto infolog = std::make_shared<RawLam::InfoLog>();
+
+		infolog->border.offsets.resize(header.num_border + 1);
+		infolog->sapwood.offsets.resize(header.num_sapwood + 1);
+		cursor.read(infolog->border.offsets.data(), infolog->border.offsets.size());
+		cursor.read(infolog->sapwood.offsets.data(), infolog->sapwood.offsets.size());
+
+		if (!valid_offsets(infolog->border.offsets, header.num_border_points) || !valid_offsets(infolog->sapwood.offsets, header.num_sapwood_points))
+			return nullptr;
+
+		infolog->pith.resize(header.num_pith);
+		cursor.read(reinterpret_cast<float*>(infolog->pith.data()), header.num_pith * 2);
+
+		infolog->knots.resize(header.num_knots);
+		cursor.read(infolog->knots.data(), infolog->knots.size());
+
+		read_points(cursor, infolog->border);
+		read_points(cursor, infolog->sapwood);
+
+		return infolog;
+	}
+
+#pragma endregion Cache_read
+
+#pragma region Cache_write
+
+	template<typename T>
+	static void write_array(std::ofstream& out, const T* data, uint64_t count)
+	{
+		out.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+	}
+
+	bool write_infolog_cache(const RawLam::InfoLog& infolog, const std::string path)
+	{
+		InfoLogCacheHeader header;
+		if (!source_stamp(path, header.source_size, header.source_time))
+			return false;
+
+		header.num_pith = infolog.pith.size();
+		header.num_knots = infolog.knots.size();
+		header.num_border = infolog.border.size();
+		header.num_border_points = infolog.border.points.size();
+		header.num_sapwood = infolog.sapwood.size();
+		header.num_sapwood_points = infolog.sapwood.points.size();
+
+		// Written under a temporary name and renamed, so that a reader never maps half a file.
+		// The name is unique to the writer, as several processes may cache the same log at once.
+		std::string cache_path = infolog_cache_path(path);
+
+		std::random_device random;
+		std::ostringstream temp_name;
+		temp_name << cache_path << "." << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id())
+			<< "-" << random() << random() << ".tmp";
+		std::string temp_path = temp_name.str();
+
+		{
+			std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+			if (!out)
+				return false;
+
+			write_array(out, &header, 1);
+			write_array(out, infolog.border.offsets.data(), infolog.border.offsets.size());
+			write_array(out, infolog.sapwood.offsets.data(), infolog.sapwood.offsets.size());
+			write_array(out, reinterpret_cast<const float*>(infolog.pith.data()), infolog.pith.size() * 2);
+			write_array(out, infolog.knots.data(), infolog.knots.size());
+			write_array(out, reinterpret_cast<const float*>(infolog.border.points.data()), infolog.border.points.size() * 2);
+			write_array(out, reinterpret_cast<const float*>(infolog.sapwood.points.data()), infolog.sapwood.points.size() * 2);
+
+			if (!out)
+			{
+				out.close();
+				std::remove(temp_path.c_str());
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temp_path, cache_path, ec);
+		if (ec)
+		{
+			std::remove(temp_path.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+#pragma endregion Cache_write
+}
@@ -0,0 +1,61 @@
+#ifndef INFOLOG_CACHE_H
+#define INFOLOG_CACHE_H
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+#include "InfoLog.h"
+
+namespace DeepSight
+{
+	/*
+	Flat binary copy of a parsed InfoLog, written next to the InfoLog TIFF on the
+	first load and memory-mapped on later ones. The file is a header followed by
+	the pith, the knots and the border and sapwood outlines, each outline set
+	stored as an array of offsets into one array of points. Every array is stored
+	as the InfoLog keeps it in memory, so a reload copies each one out of the
+	mapping with a single memcpy. The header keeps the size and modification time
+	of the TIFF, so that a cache of an older TIFF is ignored and rewritten.
+	*/
+	struct InfoLogCacheHeader
+	{
+		static const uint32_t MAGIC = 0x474c5344; // "DSLG"
+		static const uint32_t VERSION = 2;
+
+		uint32_t magic = MAGIC;
+		uint32_t version = VERSION;
+
+		// Size and last write time of the InfoLog TIFF the cache was made from
+		uint64_t source_size = 0;
+		int64_t source_time = 0;
+
+		uint64_t num_pith = 0, num_knots = 0;
+		uint64_t num_border = 0, num_border_points = 0;
+		uint64_t num_sapwood = 0, num_sapwood_points = 0;
+	};
+
+	// Knot as stored in the cache. The layout is that of RawLam::knot, so that the knots
+	// are read and written as one array.
+	struct InfoLogCacheKnot
+	{
+		float radius, length, volume;
+		int32_t index;
+		int32_t dead_knot_border;
+		float start[3], end[3];
+	};
+
+	static_assert(sizeof(InfoLogCacheKnot) == sizeof(RawLam::knot), "cached knots are expected to match RawLam::knot");
+
+	// Path of the cache of an InfoLog TIFF.
+	std::string infolog_cache_path(const std::string path);
+
+	// Read the cache of the InfoLog TIFF at path. Returns nullptr if there is none, or if
+	// it is damaged or older than the TIFF.
+	RawLam::InfoLog::Ptr read_infolog_cache(const std::string path);
+
+	// Write the cache of the InfoLog TIFF at path. Returns false if it could not be written.
+	bool write_infolog_cache(const RawLam::InfoLog& infolog, const std::string path);
+}
+
+#endif
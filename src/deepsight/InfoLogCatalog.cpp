@@ -0,0 +1,83 @@
+#include "InfoLogCatalog.h"
+#include "ReadWrite.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+namespace RawLam
+{
+	InfoLogSummary InfoLogCatalog::summarize(const InfoLog& infolog, double z_spacing)
+	{
+		InfoLogSummary summary;
+		summary.num_knots = (int)infolog.knots.size();
+		summary.num_slices = (int)std::max({ infolog.pith.size(), infolog.border.size(), infolog.sapwood.size() });
+
+		for (const knot& k : infolog.knots)
+			summary.knot_volume += k.volume;
+
+		for (size_t i = 1; i < infolog.pith.size(); ++i)
+		{
+			Eigen::Vector2d d = (infolog.pith[i] - infolog.pith[i - 1]).cast<double>();
+			summary.pith_length += std::sqrt(d.squaredNorm() + z_spacing * z_spacing);
+		}
+
+		return summary;
+	}
+
+	size_t InfoLogCatalog::load(const std::vector<std::string>& paths, bool use_cache, unsigned int num_threads)
+	{
+		std::vector<InfoLog::Ptr> logs(paths.size());
+		std::vector<InfoLogSummary> summaries(paths.size());
+
+		// Every log is parsed and summarized on its own thread, only the catalog is filled in order
+		tbb::task_arena arena(num_threads > 0 ? (int)num_threads : tbb::task_arena::automatic);
+		arena.execute([&]
+			{
+				tbb::parallel_for(size_t(0), paths.size(), [&](size_t i)
+					{
+						logs[i] = DeepSight::load_infolog(paths[i], false, use_cache);
+						if (logs[i])
+							summaries[i] = summarize(*logs[i], m_z_spacing);
+					});
+			});
+
+		size_t num_loaded = 0;
+		for (size_t i = 0; i < paths.size(); ++i)
+		{
+			if (!logs[i])
+			{
+				std::cerr << "Failed to load InfoLog '" << paths[i] << "'" << std::endl;
+				continue;
+			}
+
+			logs[i]->name = std::filesystem::path(paths[i]).stem().string();
+
+			auto found = m_index.find(logs[i]->name);
+			if (found != m_index.end())
+			{
+				m_logs[found->second] = logs[i];
+				m_summaries[found->second] = summaries[i];
+			}
+			else
+			{
+				m_index[logs[i]->name] = m_logs.size();
+				m_names.push_back(logs[i]->name);
+				m_logs.push_back(logs[i]);
+				m_summaries.push_back(summaries[i]);
+			}
+
+			++num_loaded;
+		}
+
+		return num_loaded;
+	}
+
+	int InfoLogCatalog::find(const std::string& name) const
+	{
+		auto found = m_index.find(name);
+		return found != m_index.end() ? (int)found->second : -1;
+	}
+}
@@ -0,0 +1,64 @@
+#ifndef INFOLOG_CATALOG_H
+#define INFOLOG_CATALOG_H
+
+#include "InfoLog.h"
+
+#include <unordered_map>
+
+namespace RawLam
+{
+	// Summary of a log in an InfoLogCatalog. Plain data, so that the summaries of all
+	// logs can be handed through the C API as one array.
+	struct InfoLogSummary
+	{
+		int num_knots = 0;
+
+		// Slices covered by the pith or the outlines, whichever has more
+		int num_slices = 0;
+
+		double knot_volume = 0.0;
+
+		// Length of the pith polyline, with slices z_spacing apart
+		double pith_length = 0.0;
+	};
+
+	/*
+	InfoLogs of many logs, loaded in parallel and kept by the name of their file without
+	extension. Logs and their summaries are stored by position, in the order they were
+	added, and are read in place.
+	*/
+	class InfoLogCatalog
+	{
+	public:
+		using Ptr = std::shared_ptr<InfoLogCatalog>;
+
+		InfoLogCatalog(double z_spacing = 1.0) : m_z_spacing(z_spacing) {}
+
+		// Load InfoLogs on num_threads threads (0 uses all cores), through the InfoLog cache if
+		// use_cache. A log named like one in the catalog replaces it, and paths that fail to
+		// load are left out. Returns the number of logs loaded.
+		size_t load(const std::vector<std::string>& paths, bool use_cache = true, unsigned int num_threads = 0);
+
+		size_t size() const { return m_logs.size(); }
+
+		// Position of the log called name, or -1
+		int find(const std::string& name) const;
+
+		const std::string& name(size_t i) const { return m_names[i]; }
+		const InfoLog::Ptr& log(size_t i) const { return m_logs[i]; }
+		const InfoLogSummary& summary(size_t i) const { return m_summaries[i]; }
+		const std::vector<InfoLogSummary>& summaries() const { return m_summaries; }
+
+		static InfoLogSummary summarize(const InfoLog& infolog, double z_spacing = 1.0);
+
+	private:
+		double m_z_spacing;
+
+		std::vector<std::string> m_names;
+		std::vector<InfoLog::Ptr> m_logs;
+		std::vector<InfoLogSummary> m_summaries;
+		std::unordered_map<std::string, size_t> m_index;
+	};
+}
+
+#endif
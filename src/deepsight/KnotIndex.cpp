@@ -0,0 +1,394 @@
+#include "KnotIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace RawLam
+{
+#pragma region Distances
+
+	// Squared distance between the segment from a to b and the box [min, max]. Along the
+	// segment, every axis is below, inside or above the box between the points where it
+	// crosses a face, and on each of these pieces the squared distance is a quadratic in t.
+	static float segment_box_distance2(const Eigen::Vector3f& a, const Eigen::Vector3f& b, const Eigen::Vector3f& min, const Eigen::Vector3f& max)
+	{
+		const Eigen::Vector3f d = b - a;
+
+		float breaks[8];
+		int num_breaks = 0;
+		breaks[num_breaks++] = 0.0f;
+		breaks[num_breaks++] = 1.0f;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			if (d[i] == 0.0f) continue;
+
+			for (float face : { min[i], max[i] })
+			{
+				float t = (face - a[i]) / d[i];
+				if (t > 0.0f && t < 1.0f)
+					breaks[num_breaks++] = t;
+			}
+		}
+
+		std::sort(breaks, breaks + num_breaks);
+
+		float best = std::numeric_limits<float>::max();
+
+		for (int k = 0; k + 1 < num_breaks; ++k)
+		{
+			float t0 = breaks[k], t1 = breaks[k + 1];
+			float tm = 0.5f * (t0 + t1);
+
+			// Distance to the nearest face of every axis outside of the box is (a + t d - face)
+			float num = 0.0f, den = 0.0f;
+			float bound[3];
+			bool outside[3];
+
+			for (int i = 0; i < 3; ++i)
+			{
+				float x = a[i] + tm * d[i];
+				outside[i] = x < min[i] || x > max[i];
+				bound[i] = x < min[i] ? min[i] : max[i];
+
+				if (outside[i])
+				{
+					num -= d[i] * (a[i] - bound[i]);
+					den += d[i] * d[i];
+				}
+			}
+
+			float t = den > 0.0f ? std::min(std::max(num / den, t0), t1) : t0;
+
+			float dist2 = 0.0f;
+			for (int i = 0; i < 3; ++i)
+			{
+				if (!outside[i]) continue;
+				float e = a[i] + t * d[i] - bound[i];
+				dist2 += e * e;
+			}
+
+			best = std::min(best, dist2);
+		}
+
+		return best;
+	}
+
+	static float point_segment_distance2(const Eigen::Vector3f& p, const Eigen::Vector3f& a, const Eigen::Vector3f& b)
+	{
+		const Eigen::Vector3f d = b - a;
+		float len2 = d.squaredNorm();
+		float t = len2 > 0.0f ? std::min(std::max((p - a).dot(d) / len2, 0.0f), 1.0f) : 0.0f;
+
+		return (a + t * d - p).squaredNorm();
+	}
+
+	// Squared distance between the segments p1-q1 and p2-q2, from the closest points of both
+	static float segment_segment_distance2(const Eigen::Vector3f& p1, const Eigen::Vector3f& q1, const Eigen::Vector3f& p2, const Eigen::Vector3f& q2)
+	{
+		const Eigen::Vector3f d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+		float a = d1.squaredNorm(), e = d2.squaredNorm(), f = d2.dot(r);
+		float s, t;
+
+		if (a <= 0.0f && e <= 0.0f)
+			return r.squaredNorm();
+
+		if (a <= 0.0f)
+		{
+			s = 0.0f;
+			t = std::min(std::max(f / e, 0.0f), 1.0f);
+		}
+		else
+		{
+			float c = d1.dot(r);
+			if (e <= 0.0f)
+			{
+				t = 0.0f;
+				s = std::min(std::max(-c / a, 0.0f), 1.0f);
+			}
+			else
+			{
+				float b = d1.dot(d2);
+				float denom = a * e - b * b;
+
+				// Parallel segments have no unique closest points, any s works
+				s = denom > 0.0f ? std::min(std::max((b * f - c * e) / denom, 0.0f), 1.0f) : 0.0f;
+				t = (b * s + f) / e;
+
+				if (t < 0.0f)
+				{
+					t = 0.0f;
+					s = std::min(std::max(-c / a, 0.0f), 1.0f);
+				}
+				else if (t > 1.0f)
+				{
+					t = 1.0f;
+					s = std::min(std::max((b - c) / a, 0.0f), 1.0f);
+				}
+			}
+		}
+
+		return (p1 + s * d1 - (p2 + t * d2)).squaredNorm();
+	}
+
+	static float point_box_distance2(const Eigen::Vector3f& p, const Eigen::Vector3f& min, const Eigen::Vector3f& max)
+	{
+		float dist2 = 0.0f;
+		for (int i = 0; i < 3; ++i)
+		{
+			float e = std::max(std::max(min[i] - p[i], p[i] - max[i]), 0.0f);
+			dist2 += e * e;
+		}
+
+		return dist2;
+	}
+
+	static bool boxes_overlap(const Eigen::Vector3f& min0, const Eigen::Vector3f& max0, const Eigen::Vector3f& min1, const Eigen::Vector3f& max1)
+	{
+		return (min0.array() <= max1.array()).all() && (min1.array() <= max0.array()).all();
+	}
+
+	// Slab test of the segment from a to b against the box [min, max]
+	static bool segment_overlaps_box(const Eigen::Vector3f& a, const Eigen::Vector3f& b, const Eigen::Vector3f& min, const Eigen::Vector3f& max)
+	{
+		const Eigen::Vector3f d = b - a;
+		float t0 = 0.0f, t1 = 1.0f;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			if (d[i] == 0.0f)
+			{
+				if (a[i] < min[i] || a[i] > max[i])
+					return false;
+				continue;
+			}
+
+			float inv = 1.0f / d[i];
+			float ta = (min[i] - a[i]) * inv, tb = (max[i] - a[i]) * inv;
+			if (ta > tb) std::swap(ta, tb);
+
+			t0 = std::max(t0, ta);
+			t1 = std::min(t1, tb);
+			if (t0 > t1)
+				return false;
+		}
+
+		return true;
+	}
+
+#pragma endregion Distances
+
+	KnotIndex::KnotIndex(const std::vector<knot>& knots)
+	{
+		m_capsules.reserve(knots.size());
+		for (size_t i = 0; i < knots.size(); ++i)
+			m_capsules.push_back(Capsule{ knots[i].start, knots[i].end, knots[i].radius, (int)i });
+
+		if (m_capsules.empty())
+			return;
+
+		m_nodes.reserve(2 * (m_capsules.size() / LEAF_SIZE + 1));
+		build(0, (int)m_capsules.size());
+	}
+
+	// Split the capsules at the median of their centres along the longest axis of the centres
+	int KnotIndex::build(int first, int count)
+	{
+		int index = (int)m_nodes.size();
+		m_nodes.push_back(Node());
+
+		Eigen::Vector3f min = Eigen::Vector3f::Constant(std::numeric_limits<float>::max()), max = -min;
+		Eigen::Vector3f cmin = min, cmax = max;
+
+		for (int i = first; i < first + count; ++i)
+		{
+			const Capsule& c = m_capsules[i];
+			Eigen::Vector3f r = Eigen::Vector3f::Constant(c.radius);
+
+			min = min.cwiseMin(c.a.cwiseMin(c.b) - r);
+			max = max.cwiseMax(c.a.cwiseMax(c.b) + r);
+
+			Eigen::Vector3f centre = 0.5f * (c.a + c.b);
+			cmin = cmin.cwiseMin(centre);
+			cmax = cmax.cwiseMax(centre);
+		}
+
+		m_nodes[index].min = min;
+		m_nodes[index].max = max;
+
+		if (count <= LEAF_SIZE)
+		{
+			m_nodes[index].first = first;
+			m_nodes[index].count = count;
+			m_nodes[index].right = -1;
+			return index;
+		}
+
+		int axis;
+		(cmax - cmin).maxCoeff(&axis);
+
+		int half = count / 2;
+		std::nth_element(m_capsules.begin() + first, m_capsules.begin() + first + half, m_capsules.begin() + first + count,
+			[axis](const Capsule& c0, const Capsule& c1) { return c0.a[axis] + c0.b[axis] < c1.a[axis] + c1.b[axis]; });
+
+		build(first, half);
+		int right = build(first + half, count - half);
+
+		m_nodes[index].first = first;
+		m_nodes[index].count = 0;
+		m_nodes[index].right = right;
+
+		return index;
+	}
+
+	template<typename NodeTestT, typename CapsuleTestT>
+	void KnotIndex::collect(const NodeTestT& node_test, const CapsuleTestT& capsule_test, std::vector<int>& result) const
+	{
+		if (m_nodes.empty())
+			return;
+
+		int stack[64];
+		int top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			int index = stack[--top];
+			const Node& node = m_nodes[index];
+
+			if (!node_test(node.min, node.max))
+				continue;
+
+			if (node.count > 0)
+			{
+				for (int i = node.first; i < node.first + node.count; ++i)
+					if (capsule_test(m_capsules[i]))
+						result.push_back(m_capsules[i].knot);
+			}
+			else
+			{
+				stack[top++] = node.right;
+				stack[top++] = index + 1;
+			}
+		}
+	}
+
+	void KnotIndex::query_box(const Eigen::Vector3f& min, const Eigen::Vector3f& max, std::vector<int>& result) const
+	{
+		collect(
+			[&](const Eigen::Vector3f& node_min, const Eigen::Vector3f& node_max) { return boxes_overlap(min, max, node_min, node_max); },
+			[&](const Capsule& c) { return segment_box_distance2(c.a, c.b, min, max) <= c.radius * c.radius; },
+			result);
+	}
+
+	void KnotIndex::query_segment(const Eigen::Vector3f& a, const Eigen::Vector3f& b, std::vector<int>& result) const
+	{
+		collect(
+			[&](const Eigen::Vector3f& node_min, const Eigen::Vector3f& node_max) { return segment_overlaps_box(a, b, node_min, node_max); },
+			[&](const Capsule& c) { return segment_segment_distance2(a, b, c.a, c.b) <= c.radius * c.radius; },
+			result);
+	}
+
+	int KnotIndex::nearest(const Eigen::Vector3f& p, float& distance, float max_distance) const
+	{
+		int best = -1;
+		distance = max_distance;
+
+		if (m_nodes.empty())
+			return best;
+
+		int stack[64];
+		int top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			int index = stack[--top];
+			const Node& node = m_nodes[index];
+
+			// Capsules lie inside the box of their node, so none of them is nearer than the box
+			if (point_box_distance2(p, node.min, node.max) > distance * distance)
+				continue;
+
+			if (node.count > 0)
+			{
+				for (int i = node.first; i < node.first + node.count; ++i)
+				{
+					const Capsule& c = m_capsules[i];
+					float d = std::max(std::sqrt(point_segment_distance2(p, c.a, c.b)) - c.radius, 0.0f);
+
+					if (d < distance || (best < 0 && d <= distance))
+					{
+						distance = d;
+						best = c.knot;
+					}
+				}
+			}
+			else
+			{
+				// The nearer child is pushed last, so that it is searched first
+				const Node& left = m_nodes[index + 1];
+				const Node& right = m_nodes[node.right];
+
+				bool left_first = point_box_distance2(p, left.min, left.max) <= point_box_distance2(p, right.min, right.max);
+
+				stack[top++] = left_first ? node.right : index + 1;
+				stack[top++] = left_first ? index + 1 : node.right;
+			}
+		}
+
+		return best;
+	}
+
+#pragma region Batch_queries
+
+	template<typename QueryT>
+	void KnotIndex::batch(size_t num_queries, const QueryT& query, std::vector<int>& offsets, std::vector<int>& result) const
+	{
+		std::vector<std::vector<int>> hits(num_queries);
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, num_queries), [&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t i = range.begin(); i < range.end(); ++i)
+					query(i, hits[i]);
+			});
+
+		offsets.resize(num_queries + 1);
+		offsets[0] = 0;
+		for (size_t i = 0; i < num_queries; ++i)
+			offsets[i + 1] = offsets[i] + (int)hits[i].size();
+
+		result.resize(offsets[num_queries]);
+		for (size_t i = 0; i < num_queries; ++i)
+			std::copy(hits[i].begin(), hits[i].end(), result.begin() + offsets[i]);
+	}
+
+	void KnotIndex::query_boxes(const std::vector<Eigen::Vector3f>& min, const std::vector<Eigen::Vector3f>& max,
+		std::vector<int>& offsets, std::vector<int>& result) const
+	{
+		batch(std::min(min.size(), max.size()), [&](size_t i, std::vector<int>& hits) { query_box(min[i], max[i], hits); }, offsets, result);
+	}
+
+	void KnotIndex::query_segments(const std::vector<Eigen::Vector3f>& a, const std::vector<Eigen::Vector3f>& b,
+		std::vector<int>& offsets, std::vector<int>& result) const
+	{
+		batch(std::min(a.size(), b.size()), [&](size_t i, std::vector<int>& hits) { query_segment(a[i], b[i], hits); }, offsets, result);
+	}
+
+	void KnotIndex::nearest(const std::vector<Eigen::Vector3f>& points, std::vector<int>& result, std::vector<float>& distances, float max_distance) const
+	{
+		result.resize(points.size());
+		distances.resize(points.size());
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, points.size()), [&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t i = range.begin(); i < range.end(); ++i)
+					result[i] = nearest(points[i], distances[i], max_distance);
+			});
+	}
+
+#pragma endregion Batch_queries
+}
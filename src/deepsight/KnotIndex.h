@@ -0,0 +1,77 @@
+#ifndef KNOT_INDEX_H
+#define KNOT_INDEX_H
+
+#include "InfoLog.h"
+
+#include <limits>
+
+namespace RawLam
+{
+	/*
+	Bounding-volume hierarchy over the knots of an InfoLog, each knot taken as a
+	capsule of its radius around the segment from start to end. Queries return
+	positions in the knot vector the index was built from, and only visit the
+	nodes whose boxes they touch, so they cost about log(n) per query instead of
+	a scan over all knots. The batch queries run in parallel.
+	*/
+	class KnotIndex
+	{
+	public:
+		using Ptr = std::shared_ptr<KnotIndex>;
+
+		// Knots in a leaf node
+		static const int LEAF_SIZE = 4;
+
+		KnotIndex(const std::vector<knot>& knots);
+
+		size_t size() const { return m_capsules.size(); }
+
+		// Knots whose capsule overlaps the box [min, max].
+		void query_box(const Eigen::Vector3f& min, const Eigen::Vector3f& max, std::vector<int>& result) const;
+
+		// Knots whose capsule is touched by the segment from a to b. Rays are queried as long segments.
+		void query_segment(const Eigen::Vector3f& a, const Eigen::Vector3f& b, std::vector<int>& result) const;
+
+		// Nearest knot to p, or -1 if there is none within max_distance. distance receives the
+		// distance to the surface of its capsule, 0 for points inside.
+		int nearest(const Eigen::Vector3f& p, float& distance, float max_distance = std::numeric_limits<float>::max()) const;
+
+		// Batch queries. The knots of query i are result[offsets[i]] up to result[offsets[i + 1]].
+		void query_boxes(const std::vector<Eigen::Vector3f>& min, const std::vector<Eigen::Vector3f>& max,
+			std::vector<int>& offsets, std::vector<int>& result) const;
+		void query_segments(const std::vector<Eigen::Vector3f>& a, const std::vector<Eigen::Vector3f>& b,
+			std::vector<int>& offsets, std::vector<int>& result) const;
+		void nearest(const std::vector<Eigen::Vector3f>& points, std::vector<int>& result, std::vector<float>& distances,
+			float max_distance = std::numeric_limits<float>::max()) const;
+
+	private:
+		struct Capsule
+		{
+			Eigen::Vector3f a, b;
+			float radius;
+			int knot;
+		};
+
+		// Nodes are stored depth first. The left child of an inner node follows it, right
+		// is the position of the right child. Leaves hold capsules [first, first + count).
+		struct Node
+		{
+			Eigen::Vector3f min, max;
+			int first, count, right;
+		};
+
+		int build(int first, int count);
+
+		// Visit the nodes that pass node_test and collect the knots of the capsules that pass capsule_test
+		template<typename NodeTestT, typename CapsuleTestT>
+		void collect(const NodeTestT& node_test, const CapsuleTestT& capsule_test, std::vector<int>& result) const;
+
+		template<typename QueryT>
+		void batch(size_t num_queries, const QueryT& query, std::vector<int>& offsets, std::vector<int>& result) const;
+
+		std::vector<Capsule> m_capsules;
+		std::vector<Node> m_nodes;
+	};
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstdint>
+
+namespace DeepSight
+{
+	/*
+	Read-only memory mapping of a whole file. Pages are only read from disk when
+	they are first touched, so that large volumes can be walked in place
+	without copying them into memory first.
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const std::string path);
+		void close();
+
+		bool is_open() const { return m_data != nullptr; }
+
+		const uint8_t* data() const { return m_data; }
+		uint64_t size() const { return m_size; }
+
+	private:
+		void* m_file;
+		void* m_mapping;
+		const uint8_t* m_data;
+		uint64_t m_size;
+	};
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include "QuantizedGrid.h"
+
+#include <mutex>
+
+namespace DeepSight
+{
+	static const char* QUANTIZE_SCALE = "quantize_scale";
+	static const char* QUANTIZE_OFFSET = "quantize_offset";
+
+	void register_quantized_grids()
+	{
+		// Checking and registering are separate calls, so two threads must not run them at once
+		static std::once_flag registered;
+
+		std::call_once(registered, []
+			{
+				if (!UInt8Grid::isRegistered())
+					UInt8Grid::registerGrid();
+				if (!UInt16Grid::isRegistered())
+					UInt16Grid::registerGrid();
+				if (!HalfGrid::isRegistered())
+					HalfGrid::registerGrid();
+			});
+	}
+
+	Quantization Quantization::read(const openvdb::GridBase& grid)
+	{
+		Quantization q;
+
+		auto scale = grid.getMetadata<openvdb::FloatMetadata>(QUANTIZE_SCALE);
+		auto offset = grid.getMetadata<openvdb::FloatMetadata>(QUANTIZE_OFFSET);
+
+		if (scale && scale->value() != 0.0f)
+			q.scale = scale->value();
+		if (offset)
+			q.offset = offset->value();
+
+		return q;
+	}
+
+	void Quantization::write(openvdb::GridBase& grid) const
+	{
+		grid.insertMeta(QUANTIZE_SCALE, openvdb::FloatMetadata(scale));
+		grid.insertMeta(QUANTIZE_OFFSET, openvdb::FloatMetadata(offset));
+	}
+
+	bool is_quantized(const openvdb::GridBase& grid)
+	{
+		return grid.isType<UInt8Grid>() || grid.isType<UInt16Grid>() || grid.isType<HalfGrid>();
+	}
+
+	template<typename GridT>
+	static GridBase* create_quantized(float scale, float offset, float background)
+	{
+		Quantization quantization;
+		quantization.scale = scale != 0.0f ? scale : 1.0f;
+		quantization.offset = offset;
+
+		GridBase* grid = new GridBase();
+		grid->initialize<GridT>(quantization.encode<typename GridT::ValueType>(background));
+		quantization.write(*grid->m_grid);
+
+		return grid;
+	}
+
+	GridBase* create_quantized_grid(int type, float scale, float offset, float background)
+	{
+		switch (type)
+		{
+		case(QUANTIZED_UINT8):
+			return create_quantized<UInt8Grid>(scale, offset, background);
+		case(QUANTIZED_UINT16):
+			return create_quantized<UInt16Grid>(scale, offset, background);
+		case(QUANTIZED_HALF):
+			return create_quantized<HalfGrid>(1.0f, 0.0f, background);
+		default:
+			return nullptr;
+		}
+	}
+
+	template<typename GridT>
+	static GridBase* quantize_float(const openvdb::FloatGrid& source, float min, float max)
+	{
+		if (min >= max)
+		{
+			min = max = source.background();
+			for (auto iter = source.cbeginValueOn(); iter; ++iter)
+			{
+				min = std::min(min, *iter);
+				max = std::max(max, *iter);
+			}
+		}
+
+		GridBase* grid = new GridBase();
+		grid->m_grid = quantize<GridT>(source, Quantization::for_range<typename GridT::ValueType>(min, max));
+
+		return grid;
+	}
+
+	GridBase* quantize_grid(GridBase* grid, int type, float min, float max)
+	{
+		openvdb::FloatGrid::Ptr source = openvdb::gridPtrCast<openvdb::FloatGrid>(grid->m_grid);
+		if (!source)
+			return nullptr;
+
+		switch (type)
+		{
+		case(QUANTIZED_UINT8):
+			return quantize_float<UInt8Grid>(*source, min, max);
+		case(QUANTIZED_UINT16):
+			return quantize_float<UInt16Grid>(*source, min, max);
+		case(QUANTIZED_HALF):
+			return quantize_float<HalfGrid>(*source, min, max);
+		default:
+			return nullptr;
+		}
+	}
+
+	GridBase* dequantize_grid(GridBase* grid)
+	{
+		openvdb::FloatGrid::Ptr decoded;
+
+		if (auto source = openvdb::gridPtrCast<UInt8Grid>(grid->m_grid))
+			decoded = dequantize(*source);
+		else if (auto source = openvdb::gridPtrCast<UInt16Grid>(grid->m_grid))
+			decoded = dequantize(*source);
+		else if (auto source = openvdb::gridPtrCast<HalfGrid>(grid->m_grid))
+			decoded = dequantize(*source);
+		else
+			return nullptr;
+
+		GridBase* new_grid = new GridBase();
+		new_grid->m_grid = decoded;
+
+		return new_grid;
+	}
+
+	void requantize_grid(GridBase* grid, const openvdb::FloatGrid& values)
+	{
+		Quantization quantization = Quantization::read(*grid->m_grid);
+		openvdb::GridBase::Ptr source = grid->m_grid;
+
+		if (grid->m_grid->isType<UInt8Grid>())
+			grid->m_grid = quantize<UInt8Grid>(values, quantization);
+		else if (grid->m_grid->isType<UInt16Grid>())
+			grid->m_grid = quantize<UInt16Grid>(values, quantization);
+		else if (grid->m_grid->isType<HalfGrid>())
+			grid->m_grid = quantize<HalfGrid>(values, quantization);
+
+		// Keep name, class and every other entry of the source grid
+		for (auto iter = source->beginMeta(); iter != source->endMeta(); ++iter)
+			grid->m_grid->insertMeta(iter->first, *iter->second);
+	}
+}
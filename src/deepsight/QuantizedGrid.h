@@ -0,0 +1,265 @@
+#ifndef QUANTIZED_GRID_H
+#define QUANTIZED_GRID_H
+
+#include "GridBase.h"
+
+#include <openvdb/tools/ValueTransformer.h>
+
+#include <limits>
+#include <type_traits>
+
+namespace DeepSight
+{
+	/*
+	Grids of 8-bit, 16-bit and half-float values, for densities that do not need
+	full float precision. Integer grids store (value - offset) / scale, rounded and
+	clamped to the range of their type, and keep scale and offset in the grid
+	metadata so that both survive a round trip through a .vdb file. Values are
+	decoded to float whenever they are read or sampled.
+
+	Only storage and value access work on the quantized values directly. Filtering,
+	resampling and combining decode the whole grid into a temporary float grid and
+	encode the result again, so while they run memory peaks at the float footprint.
+	*/
+	using UInt8Tree = openvdb::tree::Tree4<uint8_t, 5, 4, 3>::Type;
+	using UInt8Grid = openvdb::Grid<UInt8Tree>;
+
+	using UInt16Tree = openvdb::tree::Tree4<uint16_t, 5, 4, 3>::Type;
+	using UInt16Grid = openvdb::Grid<UInt16Tree>;
+
+	using HalfTree = openvdb::tree::Tree4<openvdb::math::half, 5, 4, 3>::Type;
+	using HalfGrid = openvdb::Grid<HalfTree>;
+
+	enum QuantizedType
+	{
+		QUANTIZED_UINT8 = 0,
+		QUANTIZED_UINT16 = 1,
+		QUANTIZED_HALF = 2
+	};
+
+	// Register the quantized grid types with OpenVDB, so that they can be read from files.
+	// Only the first call registers them, and it is safe to call from several threads.
+	void register_quantized_grids();
+
+	struct Quantization
+	{
+		// Decoded value = offset + scale * stored value
+		float scale = 1.0f, offset = 0.0f;
+
+		// Read the quantization from the metadata of a grid. Grids without it decode 1:1.
+		static Quantization read(const openvdb::GridBase& grid);
+		void write(openvdb::GridBase& grid) const;
+
+		// Map [min, max] onto the range of ValueT. Half values are stored unscaled.
+		template<typename ValueT>
+		static Quantization for_range(float min, float max)
+		{
+			Quantization q;
+
+			if constexpr (std::is_integral<ValueT>::value)
+			{
+				if (max > min)
+				{
+					q.offset = min;
+					q.scale = (max - min) / (float)std::numeric_limits<ValueT>::max();
+				}
+			}
+
+			return q;
+		}
+
+		template<typename ValueT>
+		ValueT encode(float value) const
+		{
+			float stored = (value - offset) / scale;
+
+			if constexpr (std::is_integral<ValueT>::value)
+			{
+				stored = std::round(stored);
+				stored = std::min(std::max(stored, 0.0f), (float)std::numeric_limits<ValueT>::max());
+			}
+
+			return ValueT(stored);
+		}
+
+		template<typename ValueT>
+		float decode(ValueT value) const
+		{
+			return offset + scale * (float)value;
+		}
+	};
+
+	bool is_quantized(const openvdb::GridBase& grid);
+
+	// Encode the active voxels and tiles of a float grid into a new quantized grid.
+	template<typename GridT>
+	typename GridT::Ptr quantize(const openvdb::FloatGrid& source, const Quantization& quantization)
+	{
+		using ValueT = typename GridT::ValueType;
+
+		typename GridT::Ptr target = GridT::create(quantization.encode<ValueT>(source.background()));
+		target->setTransform(source.transform().copy());
+		target->setName(source.getName());
+		target->setGridClass(source.getGridClass());
+
+		auto encode = [&quantization](const openvdb::FloatGrid::ValueOnCIter& iter, typename GridT::Accessor& accessor)
+		{
+			ValueT value = quantization.encode<ValueT>(*iter);
+
+			if (iter.isVoxelValue())
+				accessor.setValue(iter.getCoord(), value);
+			else
+			{
+				openvdb::CoordBBox bbox;
+				iter.getBoundingBox(bbox);
+				accessor.getTree()->fill(bbox, value);
+			}
+		};
+
+		openvdb::tools::transformValues(source.cbeginValueOn(), *target, encode);
+		quantization.write(*target);
+
+		return target;
+	}
+
+	// Decode a quantized grid into a new float grid.
+	template<typename GridT>
+	openvdb::FloatGrid::Ptr dequantize(const GridT& source)
+	{
+		Quantization quantization = Quantization::read(source);
+
+		openvdb::FloatGrid::Ptr target = openvdb::FloatGrid::create(quantization.decode(source.background()));
+		target->setTransform(source.transform().copy());
+		target->setName(source.getName());
+		target->setGridClass(source.getGridClass());
+
+		auto decode = [&quantization](const typename GridT::ValueOnCIter& iter, openvdb::FloatGrid::Accessor& accessor)
+		{
+			float value = quantization.decode(*iter);
+
+			if (iter.isVoxelValue())
+				accessor.setValue(iter.getCoord(), value);
+			else
+			{
+				openvdb::CoordBBox bbox;
+				iter.getBoundingBox(bbox);
+				accessor.getTree()->fill(bbox, value);
+			}
+		};
+
+		openvdb::tools::transformValues(source.cbeginValueOn(), *target, decode);
+
+		return target;
+	}
+
+	// Trilinear sampling of a quantized grid that decodes the eight corner values to
+	// float first, so that the interpolation never runs in the stored type.
+	template<typename GridT>
+	class QuantizedSampler
+	{
+	public:
+		QuantizedSampler(const GridT& grid)
+			: m_accessor(grid.getConstAccessor()), m_transform(grid.transform()), m_quantization(Quantization::read(grid))
+		{
+		}
+
+		float value(const openvdb::Coord& ijk) const
+		{
+			return m_quantization.decode(m_accessor.getValue(ijk));
+		}
+
+		float is_sample(const openvdb::Vec3d& xyz) const
+		{
+			openvdb::Coord ijk = openvdb::Coord::floor(xyz);
+			openvdb::Vec3d t = xyz - ijk.asVec3d();
+
+			float c[2][2][2];
+			for (int dx = 0; dx < 2; ++dx)
+				for (int dy = 0; dy < 2; ++dy)
+					for (int dz = 0; dz < 2; ++dz)
+						c[dx][dy][dz] = value(ijk.offsetBy(dx, dy, dz));
+
+			double v00 = c[0][0][0] + (c[0][0][1] - c[0][0][0]) * t.z();
+			double v01 = c[0][1][0] + (c[0][1][1] - c[0][1][0]) * t.z();
+			double v10 = c[1][0][0] + (c[1][0][1] - c[1][0][0]) * t.z();
+			double v11 = c[1][1][0] + (c[1][1][1] - c[1][1][0]) * t.z();
+
+			double v0 = v00 + (v01 - v00) * t.y();
+			double v1 = v10 + (v11 - v10) * t.y();
+
+			return (float)(v0 + (v1 - v0) * t.x());
+		}
+
+		float ws_sample(const openvdb::Vec3d& xyz) const
+		{
+			return is_sample(m_transform.worldToIndex(xyz));
+		}
+
+	private:
+		typename GridT::ConstAccessor m_accessor;
+		const openvdb::math::Transform& m_transform;
+		Quantization m_quantization;
+	};
+
+#pragma region Quantized_Get_Set
+
+	template<typename GridT>
+	void get_decoded_values_is(GridBase* grid, int num_coords, const int* coords, float* values)
+	{
+		typename GridT::Ptr source = openvdb::gridPtrCast<GridT>(grid->m_grid);
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, (size_t)std::max(num_coords, 0), GridBase::BATCH_GRAIN_SIZE),
+			[&](const tbb::blocked_range<size_t>& range)
+			{
+				QuantizedSampler<GridT> sampler(*source);
+
+				for (size_t i = range.begin(); i < range.end(); ++i)
+					values[i] = sampler.value(openvdb::Coord(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]));
+			});
+	}
+
+	template<typename GridT>
+	void get_decoded_values_ws(GridBase* grid, int num_coords, const double* coords, float* values)
+	{
+		typename GridT::Ptr source = openvdb::gridPtrCast<GridT>(grid->m_grid);
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, (size_t)std::max(num_coords, 0), GridBase::BATCH_GRAIN_SIZE),
+			[&](const tbb::blocked_range<size_t>& range)
+			{
+				QuantizedSampler<GridT> sampler(*source);
+
+				for (size_t i = range.begin(); i < range.end(); ++i)
+					values[i] = sampler.ws_sample(openvdb::Vec3d(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]));
+			});
+	}
+
+	template<typename GridT>
+	void set_encoded_values(GridBase* grid, std::vector<Eigen::Vector3i>& xyz, const std::vector<float>& values)
+	{
+		typename GridT::Ptr target = openvdb::gridPtrCast<GridT>(grid->m_grid);
+		typename GridT::Accessor accessor = target->getAccessor();
+		Quantization quantization = Quantization::read(*target);
+
+		for (size_t i = 0; i < xyz.size() && i < values.size(); ++i)
+			accessor.setValue(openvdb::Coord(xyz[i].x(), xyz[i].y(), xyz[i].z()),
+				quantization.encode<typename GridT::ValueType>(values[i]));
+	}
+
+#pragma endregion Quantized_Get_Set
+
+	// Create an empty quantized grid of the given QuantizedType.
+	GridBase* create_quantized_grid(int type, float scale, float offset, float background);
+
+	// Quantize a float grid into a new grid of the given QuantizedType. Values in [min, max]
+	// are kept, if min >= max the range of the grid and its background is used.
+	GridBase* quantize_grid(GridBase* grid, int type, float min, float max);
+
+	// Decode a quantized grid into a new float grid. Returns nullptr for other grid types.
+	GridBase* dequantize_grid(GridBase* grid);
+
+	// Replace the values of a quantized grid with a float grid, keeping its type, quantization
+	// and metadata.
+	void requantize_grid(GridBase* grid, const openvdb::FloatGrid& values);
+}
+
+#endif
@@ -3,241 +3,1726 @@
 
 namespace DeepSight
 {
+#pragma region TIFF_ingest
+
+	using FloatTreeT = Grid<float>::TreeT;
+
+	// Pages are handed out to the ingest threads in slabs that match the leaf node depth,
+	// so that two partial trees never share a leaf and can be merged without blending.
+	static const unsigned int TIFF_SLAB_DEPTH = FloatTreeT::LeafNodeType::DIM;
+
+	using FloatLeafT = FloatTreeT::LeafNodeType;
+
+	// How the ingest treats the values of scalar and vector stacks. Vectors are
+	// thresholded on their length, and their statistics are those of their lengths.
+	template<typename ValueT>
+	struct TiffValue;
+
+	template<>
+	struct TiffValue<float>
+	{
+		// Marks the pixels of a reduced band that no input pixel fell into
+		static float no_value() { return -std::numeric_limits<float>::max(); }
+		static bool is_no_value(float val) { return val == no_value(); }
+
+		static float magnitude(float val) { return val; }
+		static bool below(float val, double threshold) { return val < threshold; }
+
+		static bool read_row(TiffPage& page, uint32_t y, float* dst) { return page.read_frame_row(y, dst); }
+		static const char* name() { return "density"; }
+	};
+
+	template<>
+	struct TiffValue<openvdb::Vec3f>
+	{
+		static openvdb::Vec3f no_value() { return openvdb::Vec3f(std::numeric_limits<float>::quiet_NaN()); }
+		static bool is_no_value(const openvdb::Vec3f& val) { return std::isnan(val[0]); }
+
+		static float magnitude(const openvdb::Vec3f& val) { return val.length(); }
+		static bool below(const openvdb::Vec3f& val, double threshold) { return !(val.length() >= threshold); }
+
+		static bool read_row(TiffPage& page, uint32_t y, openvdb::Vec3f* dst) { return page.read_vector_row(y, dst->asPointer()); }
+		static const char* name() { return "tiff"; }
+	};
+
+	// The values of one page that fall into a band of 8 rows starting at frame row y0.
+	// Value (x, y0 + r) is stored at data[(r - r0) * stride + x - x0], for r0 <= r < r1
+	// and x0 <= x < x1.
+	template<typename ValueT>
+	struct TiffBand
+	{
+		const ValueT* data = nullptr;
+		size_t stride = 0;
+		uint32_t x0 = 0, x1 = 0;
+		uint32_t r0 = 0, r1 = 0;
+
+		bool empty() const { return data == nullptr || r0 >= r1 || x0 >= x1; }
+	};
+
+	// Fold a partial count, mean and sum of squared differences into a running one (Chan et al.).
+	static void merge_moments(uint64_t& count, double& mean, double& m2, uint64_t other_count, double other_mean, double other_m2)
+	{
+		if (other_count == 0)
+			return;
+
+		uint64_t total = count + other_count;
+		double delta = other_mean - mean;
+
+		mean += delta * (double)other_count / (double)total;
+		m2 += other_m2 + delta * delta * (double)count * (double)other_count / (double)total;
+		count = total;
+	}
+
+	void TiffReadStats::merge(const TiffReadStats& other)
+	{
+		for (int i = 0; i < NUM_BINS; ++i)
+			histogram[i] += other.histogram[i];
+
+		active_count += other.active_count;
+		min = std::min(min, other.min);
+		max = std::max(max, other.max);
+
+		merge_moments(total_count, mean, m2, other.total_count, other.mean, other.m2);
+		variance = total_count > 0 ? m2 / (double)total_count : 0.0;
+	}
+
+	double TiffReadStats::percentile(double p) const
+	{
+		if (total_count == 0)
+			return 0.0;
+
+		double target = std::min(std::max(p, 0.0), 1.0) * (double)total_count;
+		double bin_width = (hist_max - hist_min) / NUM_BINS;
+		double cumulative = 0.0;
+
+		for (int i = 0; i < NUM_BINS; ++i)
+		{
+			if (histogram[i] > 0 && cumulative + (double)histogram[i] >= target)
+				return hist_min + bin_width * (i + (target - cumulative) / (double)histogram[i]);
+
+			cumulative += (double)histogram[i];
+		}
+
+		return hist_max;
+	}
+
+	double TiffReadStats::otsu_threshold() const
+	{
+		double total = 0.0, total_sum = 0.0;
+		for (int i = 0; i < NUM_BINS; ++i)
+		{
+			total += (double)histogram[i];
+			total_sum += (double)i * (double)histogram[i];
+		}
+
+		double weight = 0.0, sum = 0.0, best = -1.0;
+		int best_bin = 0;
+
+		// Maximise the variance between the bins below and above the split
+		for (int i = 0; i < NUM_BINS - 1; ++i)
+		{
+			weight += (double)histogram[i];
+			sum += (double)i * (double)histogram[i];
+
+			double other_weight = total - weight;
+			if (weight == 0.0)
+				continue;
+			if (other_weight == 0.0)
+				break;
+
+			double delta = sum / weight - (total_sum - sum) / other_weight;
+			double between = weight * other_weight * delta * delta;
+
+			if (between > best)
+			{
+				best = between;
+				best_bin = i;
+			}
+		}
+
+		return hist_min + (hist_max - hist_min) * (best_bin + 1) / NUM_BINS;
+	}
+
+	// Add the values of the bands of a slab to the statistics.
+	template<typename ValueT>
+	static void add_band_stats(TiffReadStats& stats, const TiffBand<ValueT>* bands, double threshold)
+	{
+		const double bin_scale = TiffReadStats::NUM_BINS / std::max(stats.hist_max - stats.hist_min, 1.0e-12);
+
+		uint64_t count = 0;
+		double sum = 0.0, sum_sq = 0.0;
+
+		for (unsigned int dz = 0; dz < TIFF_SLAB_DEPTH; ++dz)
+		{
+			const TiffBand<ValueT>& band = bands[dz];
+			if (band.empty())
+				continue;
+
+			for (uint32_t r = band.r0; r < band.r1; ++r)
+			{
+				const ValueT* row = band.data + (size_t)(r - band.r0) * band.stride;
+
+				for (uint32_t x = 0; x < band.x1 - band.x0; ++x)
+				{
+					if (TiffValue<ValueT>::is_no_value(row[x]))
+						continue;
+
+					float val = TiffValue<ValueT>::magnitude(row[x]);
+
+					count++;
+					sum += val;
+					sum_sq += (double)val * val;
+
+					stats.min = std::min(stats.min, (double)val);
+					stats.max = std::max(stats.max, (double)val);
+
+					if (val >= threshold)
+						stats.active_count++;
+
+					int bin = (int)std::floor((val - stats.hist_min) * bin_scale);
+					stats.histogram[std::min(std::max(bin, 0), TiffReadStats::NUM_BINS - 1)]++;
+				}
+			}
+		}
+
+		if (count == 0)
+			return;
+
+		double mean = sum / (double)count;
+		merge_moments(stats.total_count, stats.mean, stats.m2, count, mean, std::max(sum_sq - sum * mean, 0.0));
+	}
+
+	// The pages of a stack: the directories of one multi-page file, or the first
+	// directory of every file of a sequence of slices.
+	struct TiffStack
+	{
+		std::vector<std::string> files;
+
+		// File index and directory offset of every page. Offset 0 is the first directory.
+		std::vector<std::pair<unsigned int, uint64_t>> pages;
+	};
+
+	// Read the layout of the current directory of the TIFF as page k and restrict it
+	// to the crop margin and the region of the settings.
+	static bool open_tiff_page(TIFF* tif, int k, TiffPage& page, const TiffReadSettings& settings)
+	{
+		if (!page.open(tif, settings.native_decode))
+			return false;
+
+		if (settings.verbose)
+		{
+			std::cout << "frame " << k << std::endl;
+			std::cout << "    width: " << page.width << std::endl;
+			std::cout << "    height: " << page.height << std::endl;
+			std::cout << "    samplesperpixel: " << page.samplesperpixel << std::endl;
+			std::cout << "    bitspersample: " << page.bitspersample << std::endl;
+			std::cout << "    sampleformat: " << page.sampleformat << std::endl;
+			std::cout << "    native: " << page.native << std::endl;
+		}
+
+		uint32_t crop_x = settings.crop > page.width ? 0 : settings.crop;
+		uint32_t crop_y = settings.crop > page.height ? 0 : settings.crop;
+
+		uint32_t x0 = crop_x, x1 = page.width - crop_x;
+		uint32_t y0 = crop_y, y1 = page.height - crop_y;
+
+		const openvdb::CoordBBox& bbox = settings.bbox;
+		if (!bbox.empty())
+		{
+			x0 = std::max(x0, (uint32_t)std::max(bbox.min().x(), 0));
+			y0 = std::max(y0, (uint32_t)std::max(bbox.min().y(), 0));
+			x1 = std::min(x1, (uint32_t)std::max(bbox.max().x() + 1, 0));
+			y1 = std::min(y1, (uint32_t)std::max(bbox.max().y() + 1, 0));
+		}
+
+		page.set_window(x0, y0, x1, y1);
+
+		return true;
+	}
+
+	// Write the values of a band of page k above the threshold through the accessor, one voxel
+	// at a time. offset is added to the coordinates of every voxel.
+	template<typename TreeT>
+	static void write_band_voxels(openvdb::tree::ValueAccessor<TreeT>& accessor, const openvdb::Coord& offset, int k, uint32_t y0, const TiffBand<typename TreeT::ValueType>& band, double threshold)
+	{
+		using ValueT = typename TreeT::ValueType;
+
+		openvdb::Coord ijk(0, 0, k + offset.z());
+		int& i = ijk[0], & j = ijk[1];
+
+		for (uint32_t r = band.r0; r < band.r1; r++)
+		{
+			const ValueT* row = band.data + (size_t)(r - band.r0) * band.stride;
+			j = (int)(y0 + r) + offset.y();
+
+			for (uint32_t x = band.x0; x < band.x1; x++)
+			{
+				const ValueT& val = row[x - band.x0];
+				if (TiffValue<ValueT>::below(val, threshold))
+					continue;
+
+				i = (int)x + offset.x();
+				accessor.setValue(ijk, val);
+			}
+		}
+	}
+
+	// Build the leaf nodes of one band of 8 rows of a slab and attach every non-empty
+	// leaf to the tree in one operation. bands[dz] holds the rows of page z0+dz, y0 and
+	// z0 + offset.z() are leaf-aligned, and so are offset.x() and offset.y(). Leaves that
+	// stay empty are kept in leaf and recycled for the next block.
+	template<typename TreeT>
+	static void build_band_leaves(TreeT& tree, std::unique_ptr<typename TreeT::LeafNodeType>& leaf, const openvdb::Coord& offset, uint32_t y0, int z0, const TiffBand<typename TreeT::ValueType>* bands, double threshold)
+	{
+		using ValueT = typename TreeT::ValueType;
+		using LeafT = typename TreeT::LeafNodeType;
+
+		uint32_t xbegin = std::numeric_limits<uint32_t>::max(), xend = 0;
+		for (unsigned int dz = 0; dz < TIFF_SLAB_DEPTH; ++dz)
+		{
+			if (bands[dz].empty())
+				continue;
+
+			xbegin = std::min(xbegin, bands[dz].x0);
+			xend = std::max(xend, bands[dz].x1);
+		}
+
+		if (xbegin >= xend)
+			return;
+
+		for (uint32_t lx = xbegin & ~(LeafT::DIM - 1); lx < xend; lx += LeafT::DIM)
+		{
+			openvdb::Coord origin((int)lx + offset.x(), (int)y0 + offset.y(), z0 + offset.z());
+
+			if (!leaf)
+				leaf.reset(new LeafT(origin, openvdb::zeroVal<ValueT>(), false));
+			else
+				leaf->setOrigin(origin);
+
+			for (unsigned int dz = 0; dz < TIFF_SLAB_DEPTH; ++dz)
+			{
+				const TiffBand<ValueT>& band = bands[dz];
+				if (band.empty())
+					continue;
+
+				uint32_t xa = std::max(lx, band.x0);
+				uint32_t xb = std::min(lx + LeafT::DIM, band.x1);
+
+				for (uint32_t r = band.r0; r < band.r1; ++r)
+				{
+					const ValueT* row = band.data + (size_t)(r - band.r0) * band.stride;
+
+					for (uint32_t x = xa; x < xb; ++x)
+					{
+						const ValueT& val = row[x - band.x0];
+						if (TiffValue<ValueT>::below(val, threshold))
+							continue;
+
+						openvdb::Index offset = ((x - lx) << (2 * LeafT::LOG2DIM)) + (r << LeafT::LOG2DIM) + dz;
+						leaf->setValueOn(offset, val);
+					}
+				}
+			}
+
+			if (!leaf->isEmpty())
+				tree.addLeaf(leaf.release());
+		}
+	}
+
+	// Body for tbb::parallel_reduce over slabs of pages. Every body opens its own
+	// handles to the files, since a TIFF handle cannot be shared between threads.
+	// Pages are found through the directory offsets scanned up front, and only the
+	// pages in [page_first, page_last) are read.
+	//
+	// With a reduction factor f, a slab covers 8 * f pages and every output voxel is
+	// the average of the f * f * f input pixels it covers, so that leaves can still
+	// be built from whole slabs.
+	//
+	// ValueT is float for scalar stacks and Vec3f for vector stacks.
+	template<typename ValueT>
+	struct TiffStackReader
+	{
+		using TreeT = typename Grid<ValueT>::TreeT;
+		using LeafT = typename TreeT::LeafNodeType;
+		using BandT = TiffBand<ValueT>;
+
+		const TiffStack& stack;
+		const TiffReadSettings& settings;
+		unsigned int page_first, page_last;
+		unsigned int reduction, slab_pages;
+
+		// Slabs are counted from page -settings.offset.z() * reduction, so that they stay
+		// leaf-aligned in the output. Leaves are only built whole if the x and y offsets
+		// are leaf-aligned too.
+		int page_shift;
+		bool aligned_offset;
+
+		typename TreeT::Ptr tree;
+
+		// Largest value, or vector length, that was read
+		float max_val;
+		uint32_t width, height;
+		bool ok;
+
+		// Output voxels covered by the pages that were read, offset included
+		openvdb::CoordBBox region;
+
+		// Statistics of the loaded values, only collected if collect_stats is set
+		bool collect_stats;
+		TiffReadStats stats;
+
+		std::unique_ptr<LeafT> leaf;
+
+		// One handle per page of a slab when streaming, otherwise only the first is used.
+		// tif_files holds the file every handle was opened on.
+		std::vector<TIFF*> tifs;
+		std::vector<int> tif_files;
+		std::vector<TiffPage> pages;
+
+		// Decoded rows of every page of a slab: one band when streaming, the whole window otherwise
+		std::vector<std::vector<ValueT>> rows;
+
+		// Sums and pixel counts of a reduced band, 8 planes of 8 rows each
+		std::vector<ValueT> sums;
+		std::vector<uint32_t> counts;
+
+		TiffStackReader(const TiffStack& stack, const TiffReadSettings& settings, unsigned int page_first, unsigned int page_last, const TiffReadStats* stats_init = nullptr)
+			: stack(stack), settings(settings), page_first(page_first), page_last(page_last)
+			, reduction(std::max(settings.reduction, 1u)), slab_pages(TIFF_SLAB_DEPTH * reduction)
+			, page_shift(settings.offset.z() * (int)reduction)
+			, aligned_offset(((settings.offset.x() | settings.offset.y()) & (int)(LeafT::DIM - 1)) == 0)
+			, tree(new TreeT(openvdb::zeroVal<ValueT>())), max_val(0.0f), width(0), height(0), ok(true)
+			, collect_stats(stats_init != nullptr)
+			, tifs(slab_pages, nullptr), tif_files(slab_pages, -1), pages(slab_pages), rows(slab_pages)
+		{
+			// Only the histogram range is taken from the caller
+			if (stats_init)
+			{
+				stats.hist_min = stats_init->hist_min;
+				stats.hist_max = stats_init->hist_max;
+			}
+		}
+
+		TiffStackReader(TiffStackReader& other, tbb::split)
+			: TiffStackReader(other.stack, other.settings, other.page_first, other.page_last, other.collect_stats ? &other.stats : nullptr)
+		{
+		}
+
+		~TiffStackReader()
+		{
+			for (TIFF* tif : tifs)
+				if (tif) TIFFClose(tif);
+		}
+
+		// Open page k on handle slot, reusing the handle if it is on the same file.
+		bool open_page(unsigned int slot, unsigned int k, TiffPage& page)
+		{
+			unsigned int file = stack.pages[k].first;
+			uint64_t offset = stack.pages[k].second;
+
+			TIFF*& tif = tifs[slot];
+			bool reuse = tif && tif_files[slot] == (int)file;
+
+			if (tif && !reuse)
+			{
+				TIFFClose(tif);
+				tif = nullptr;
+			}
+
+			if (!tif)
+			{
+				tif = TIFFOpen(stack.files[file].c_str(), "r");
+				tif_files[slot] = (int)file;
+			}
+
+			bool positioned = tif != nullptr;
+			if (positioned && offset != 0)
+				positioned = TIFFSetSubDirectory(tif, offset) != 0;
+			else if (positioned && reuse)
+				positioned = TIFFSetDirectory(tif, 0) != 0;
+
+			if (!positioned)
+			{
+				std::cerr << "Could not read page " << k << " of TIFF image" << std::endl;
+				return false;
+			}
+
+			if (!open_tiff_page(tif, (int)k, page, settings))
+				return false;
+
+			width = std::max(width, page.width);
+			height = std::max(height, page.height);
+
+			return true;
+		}
+
+		// Get the rows of page dz that fall into the band starting at frame row y0.
+		// Bands of a page have to be requested in order when streaming.
+		bool fill_band(unsigned int dz, uint32_t y0, BandT& band)
+		{
+			TiffPage& page = pages[dz];
+
+			uint32_t ya = std::max(y0, page.y0);
+			uint32_t yb = std::min(y0 + LeafT::DIM, page.y1);
+
+			band = BandT();
+			if (ya >= yb || page.x0 >= page.x1)
+				return true;
+
+			band.stride = page.window_width();
+			band.x0 = page.x0;
+			band.x1 = page.x1;
+			band.r0 = ya - y0;
+			band.r1 = yb - y0;
+
+			if (!settings.streaming)
+			{
+				band.data = &rows[dz][(size_t)(ya - page.y0) * band.stride];
+				return true;
+			}
+
+			std::vector<ValueT>& buffer = rows[dz];
+			band.data = buffer.data();
+
+			for (uint32_t y = ya; y < yb; ++y)
+				if (!TiffValue<ValueT>::read_row(page, y, &buffer[(size_t)(y - ya) * band.stride]))
+					return false;
+
+			for (size_t p = 0; p < (size_t)(yb - ya) * band.stride; ++p)
+				max_val = std::max(max_val, TiffValue<ValueT>::magnitude(buffer[p]));
+
+			return true;
+		}
+
+		// Decode the whole window of a page into frame, when not streaming.
+		bool read_window(TiffPage& page, std::vector<ValueT>& frame)
+		{
+			frame.resize((size_t)page.window_width() * page.window_height());
+
+			for (uint32_t y = page.y0; y < page.y1; ++y)
+				if (!TiffValue<ValueT>::read_row(page, y, &frame[(size_t)(y - page.y0) * page.window_width()]))
+					return false;
+
+			for (const ValueT& val : frame)
+				max_val = std::max(max_val, TiffValue<ValueT>::magnitude(val));
+
+			return true;
+		}
+
+		void write_band(openvdb::tree::ValueAccessor<TreeT>& accessor, int z0, uint32_t y0, const BandT* bands)
+		{
+			if (collect_stats)
+				add_band_stats(stats, bands, settings.threshold);
+
+			if (settings.slab_leaves && aligned_offset)
+			{
+				build_band_leaves(*tree, leaf, settings.offset, y0, z0, bands, settings.threshold);
+				return;
+			}
+
+			for (unsigned int dz = 0; dz < TIFF_SLAB_DEPTH; ++dz)
+				if (!bands[dz].empty())
+					write_band_voxels(accessor, settings.offset, z0 + (int)dz, y0, bands[dz], settings.threshold);
+		}
+
+		// Average the input bands under the output band starting at row y0 into sums,
+		// and return the output bands in bands.
+		bool reduce_band(unsigned int dz_begin, unsigned int dz_end, uint32_t y0, uint32_t x_begin, uint32_t x_end, BandT* bands)
+		{
+			const uint32_t f = reduction;
+			const size_t plane_size = (size_t)LeafT::DIM * (x_end - x_begin);
+
+			sums.assign(TIFF_SLAB_DEPTH * plane_size, openvdb::zeroVal<ValueT>());
+			counts.assign(TIFF_SLAB_DEPTH * plane_size, 0);
+
+			for (unsigned int dz = dz_begin; dz < dz_end; ++dz)
+			{
+				unsigned int oz = dz / f;
+
+				for (uint32_t b = 0; b < f; ++b)
+				{
+					BandT band;
+					if (!fill_band(dz, y0 * f + b * LeafT::DIM, band))
+						return false;
+
+					if (band.empty())
+						continue;
+
+					for (uint32_t r = band.r0; r < band.r1; ++r)
+					{
+						const ValueT* row = band.data + (size_t)(r - band.r0) * band.stride;
+						size_t out_row = oz * plane_size + (size_t)((b * LeafT::DIM + r) / f) * (x_end - x_begin);
+
+						for (uint32_t x = band.x0; x < band.x1; ++x)
+						{
+							size_t n = out_row + x / f - x_begin;
+							sums[n] += row[x - band.x0];
+							counts[n]++;
+						}
+					}
+				}
+			}
+
+			for (unsigned int oz = 0; oz < TIFF_SLAB_DEPTH; ++oz)
+			{
+				BandT& band = bands[oz];
+				band = BandT();
+				band.r0 = LeafT::DIM;
+
+				for (uint32_t r = 0; r < LeafT::DIM; ++r)
+				{
+					size_t row = oz * plane_size + (size_t)r * (x_end - x_begin);
+					bool filled = false;
+
+					// Pixels nothing fell into are kept below any threshold
+					for (size_t n = row; n < row + (x_end - x_begin); ++n)
+					{
+						filled = filled || counts[n] > 0;
+						sums[n] = counts[n] > 0 ? ValueT(sums[n] / (float)counts[n]) : TiffValue<ValueT>::no_value();
+					}
+
+					if (filled)
+					{
+						band.r0 = std::min(band.r0, r);
+						band.r1 = r + 1;
+					}
+				}
+
+				if (band.r0 >= band.r1)
+					continue;
+
+				band.data = &sums[oz * plane_size + (size_t)band.r0 * (x_end - x_begin)];
+				band.stride = x_end - x_begin;
+				band.x0 = x_begin;
+				band.x1 = x_end;
+			}
+
+			return true;
+		}
+
+		// Slabs that hold the pages [page_first, page_last)
+		tbb::blocked_range<int> slabs() const { return slab_range((int)page_first + page_shift, (int)page_last + page_shift, (int)slab_pages); }
+
+		void read_slab(int slab, openvdb::tree::ValueAccessor<TreeT>& accessor)
+		{
+			const uint32_t f = reduction;
+
+			// First page of the slab, a multiple of f that may lie before the first page
+			int64_t k0 = (int64_t)slab * slab_pages - page_shift;
+			unsigned int dz_begin = (unsigned int)(std::max(k0, (int64_t)page_first) - k0);
+			unsigned int dz_end = (unsigned int)(std::min(k0 + slab_pages, (int64_t)page_last) - k0);
+
+			// Rows and columns covered by the windows of the slab, in output pixels
+			uint32_t y_begin = std::numeric_limits<uint32_t>::max(), y_end = 0;
+			uint32_t x_begin = std::numeric_limits<uint32_t>::max(), x_end = 0;
+
+			for (unsigned int dz = dz_begin; dz < dz_end && ok; ++dz)
+			{
+				TiffPage& page = pages[dz];
+
+				ok = open_page(settings.streaming ? dz : 0, (unsigned int)(k0 + dz), page);
+				if (!ok) break;
+
+				if (settings.streaming)
+					rows[dz].resize((size_t)LeafT::DIM * page.window_width());
+				else
+					ok = read_window(page, rows[dz]);
+
+				if (page.x0 >= page.x1 || page.y0 >= page.y1)
+					continue;
+
+				y_begin = std::min(y_begin, page.y0 / f);
+				y_end = std::max(y_end, (page.y1 + f - 1) / f);
+				x_begin = std::min(x_begin, page.x0 / f);
+				x_end = std::max(x_end, (page.x1 + f - 1) / f);
+			}
+
+			// Output z of the first page of the slab, before the offset
+			int z0 = slab * (int)TIFF_SLAB_DEPTH - settings.offset.z();
+			BandT bands[TIFF_SLAB_DEPTH];
+
+			if (x_begin < x_end && y_begin < y_end)
+			{
+				region.expand(openvdb::Coord((int)x_begin, (int)y_begin, z0 + (int)(dz_begin / f)) + settings.offset);
+				region.expand(openvdb::Coord((int)x_end - 1, (int)y_end - 1, z0 + (int)((dz_end - 1) / f)) + settings.offset);
+			}
+
+			for (uint32_t y0 = y_begin & ~(LeafT::DIM - 1); y0 < y_end && ok; y0 += LeafT::DIM)
+			{
+				if (f > 1)
+				{
+					ok = reduce_band(dz_begin, dz_end, y0, x_begin, x_end, bands);
+				}
+				else
+				{
+					for (unsigned int dz = 0; dz < TIFF_SLAB_DEPTH && ok; ++dz)
+					{
+						bands[dz] = BandT();
+						if (dz >= dz_begin && dz < dz_end)
+							ok = fill_band(dz, y0, bands[dz]);
+					}
+				}
+
+				if (ok)
+					write_band(accessor, z0, y0, bands);
+			}
+		}
+
+		void operator()(const tbb::blocked_range<int>& slabs)
+		{
+			if (!ok) return;
+
+			openvdb::tree::ValueAccessor<TreeT> accessor(*tree);
+
+			for (int slab = slabs.begin(); slab < slabs.end() && ok; ++slab)
+				read_slab(slab, accessor);
+		}
+
+		void join(TiffStackReader& other)
+		{
+			ok = ok && other.ok;
+			max_val = std::max(max_val, other.max_val);
+			width = std::max(width, other.width);
+			height = std::max(height, other.height);
+
+			if (collect_stats)
+				stats.merge(other.stats);
+
+			region.expand(other.region);
+			tree->merge(*other.tree);
+		}
+	};
+
+	// Number of pixels sampled from every page when choosing the threshold
+	static const uint64_t TIFF_THRESHOLD_SAMPLES = 1 << 16;
+
+	// Sample up to threshold_sample_pages pages spread evenly over [page_first, page_last)
+	// into a histogram over the range of the sampled values. Only every step-th row and
+	// column of the region of a page is sampled, so the pass costs a fraction of a full read.
+	template<typename ValueT>
+	static bool sample_stack_stats(const TiffStack& stack, const TiffReadSettings& settings, unsigned int page_first, unsigned int page_last, TiffReadStats& stats)
+	{
+		unsigned int num_pages = page_last - page_first;
+		unsigned int num_samples = std::min(std::max(settings.threshold_sample_pages, 1u), num_pages);
+
+		if (num_samples == 0)
+			return false;
+
+		TiffReadSettings page_settings = settings;
+		page_settings.verbose = false;
+
+		std::vector<std::vector<float>> samples(num_samples);
+		std::atomic<bool> ok(true);
+
+		tbb::task_arena arena(settings.num_threads > 0 ? (int)settings.num_threads : tbb::task_arena::automatic);
+		arena.execute([&]
+			{
+				tbb::parallel_for(0u, num_samples, [&](unsigned int s)
+					{
+						// Center of the s-th of num_samples equal runs of pages
+						unsigned int k = page_first + (unsigned int)(((2 * (uint64_t)s + 1) * num_pages) / (2 * (uint64_t)num_samples));
+						uint64_t offset = stack.pages[k].second;
+
+						TIFF* tif = TIFFOpen(stack.files[stack.pages[k].first].c_str(), "r");
+						if (!tif || (offset != 0 && !TIFFSetSubDirectory(tif, offset)))
+						{
+							std::cerr << "Could not read page " << k << " of TIFF image" << std::endl;
+							if (tif) TIFFClose(tif);
+							ok = false;
+							return;
+						}
+
+						TiffPage page;
+						if (open_tiff_page(tif, (int)k, page, page_settings))
+						{
+							uint64_t area = (uint64_t)page.window_width() * page.window_height();
+							uint32_t step = std::max((uint32_t)std::sqrt((double)area / TIFF_THRESHOLD_SAMPLES), 1u);
+
+							std::vector<ValueT> row(page.window_width());
+							for (uint32_t y = page.y0 + step / 2; y < page.y1; y += step)
+							{
+								if (!TiffValue<ValueT>::read_row(page, y, row.data()))
+								{
+									ok = false;
+									break;
+								}
+
+								for (size_t x = step / 2; x < row.size(); x += step)
+									samples[s].push_back(TiffValue<ValueT>::magnitude(row[x]));
+							}
+						}
+						else
+							ok = false;
+
+						TIFFClose(tif);
+					});
+			});
+
+		if (!ok)
+			return false;
+
+		double vmin = std::numeric_limits<double>::max(), vmax = -std::numeric_limits<double>::max();
+		for (auto& values : samples)
+			for (float val : values)
+			{
+				vmin = std::min(vmin, (double)val);
+				vmax = std::max(vmax, (double)val);
+			}
+
+		stats = TiffReadStats();
+		if (vmin > vmax)
+			return true;
+
+		stats.hist_min = vmin;
+		stats.hist_max = vmax > vmin ? vmax : vmin + 1.0;
+		stats.min = vmin;
+		stats.max = vmax;
+
+		const double bin_scale = TiffReadStats::NUM_BINS / (stats.hist_max - stats.hist_min);
+
+		for (auto& values : samples)
+		{
+			double sum = 0.0, sum_sq = 0.0;
+
+			for (float val : values)
+			{
+				int bin = (int)std::floor((val - stats.hist_min) * bin_scale);
+				stats.histogram[std::min(std::max(bin, 0), TiffReadStats::NUM_BINS - 1)]++;
+
+				sum += val;
+				sum_sq += (double)val * val;
+			}
+
+			uint64_t count = values.size();
+			if (count == 0)
+				continue;
+
+			double mean = sum / (double)count;
+			merge_moments(stats.total_count, stats.mean, stats.m2, count, mean, std::max(sum_sq - sum * mean, 0.0));
+		}
+
+		stats.variance = stats.total_count > 0 ? stats.m2 / (double)stats.total_count : 0.0;
+
+		return true;
+	}
+
+	// Replace the threshold of the settings with the one of their threshold mode,
+	// chosen from a sample of the pages in [page_first, page_last).
+	template<typename ValueT>
+	static bool choose_threshold(const TiffStack& stack, TiffReadSettings& settings, unsigned int page_first, unsigned int page_last)
+	{
+		if (settings.threshold_mode == TiffReadSettings::THRESHOLD_FIXED)
+			return true;
+
+		TiffReadStats sampled;
+		if (!sample_stack_stats<ValueT>(stack, settings, page_first, page_last, sampled))
+		{
+			std::cerr << "Failed to sample TIFF pages for the threshold" << std::endl;
+			return false;
+		}
+
+		if (sampled.total_count == 0)
+			return true;
+
+		if (settings.threshold_mode == TiffReadSettings::THRESHOLD_OTSU)
+		{
+			settings.threshold = sampled.otsu_threshold();
+			if (settings.verbose)
+				std::cout << "Threshold (Otsu): " << settings.threshold << std::endl;
+		}
+		else
+		{
+			settings.threshold = sampled.percentile(settings.threshold_percentile);
+			if (settings.verbose)
+				std::cout << "Threshold (" << settings.threshold_percentile * 100.0 << "th percentile): " << settings.threshold << std::endl;
+		}
+
+		if (settings.verbose)
+			std::cout << "Sampled " << sampled.total_count << " values, range " << sampled.min << " - " << sampled.max << std::endl;
+
+		return true;
+	}
+
 	//template<typename T>
 	Grid<float>::Ptr load_scalar_tiff(const std::string path, double threshold, unsigned int crop, bool verbose)
 	{
-		//bool verbose = false;
-		unsigned int crop_x = crop, crop_y = crop;
+		TiffReadSettings settings;
+		settings.threshold = threshold;
+		settings.crop = crop;
+		settings.verbose = verbose;
+
+		return load_scalar_tiff(path, settings);
+	}
+
+	// The z range of the region of the settings selects the pages [page_first, page_last)
+	// of the stack. Pages outside of it are never opened.
+	static void stack_page_range(const TiffStack& stack, const TiffReadSettings& settings, unsigned int& page_first, unsigned int& page_last)
+	{
+		unsigned int num_pages = (unsigned int)stack.pages.size();
+
+		page_first = 0;
+		page_last = num_pages;
+
+		if (!settings.bbox.empty())
+		{
+			page_first = (unsigned int)std::min(std::max(settings.bbox.min().z(), 0), (int)num_pages);
+			page_last = (unsigned int)std::min(std::max(settings.bbox.max().z() + 1, (int)page_first), (int)num_pages);
+		}
+	}
+
+	// Read the pages of a stack into a new scalar or vector tree, with the offset of the
+	// settings applied. The threshold of the settings is replaced by the one chosen for
+	// their threshold mode. region receives the output voxels covered by the pages.
+	template<typename ValueT>
+	static typename Grid<ValueT>::TreeT::Ptr read_stack_tree(const TiffStack& stack, TiffReadSettings& settings, TiffReadStats* stats, openvdb::CoordBBox* region = nullptr)
+	{
+		if (settings.reduction < 1)
+		{
+			std::cerr << "Reduction factor has to be at least 1" << std::endl;
+			return nullptr;
+		}
+
+		unsigned int page_first, page_last;
+		stack_page_range(stack, settings, page_first, page_last);
+
+		// The threshold may still have to be chosen from the region
+		if (!choose_threshold<ValueT>(stack, settings, page_first, page_last))
+			return nullptr;
+
+		TiffStackReader<ValueT> reader(stack, settings, page_first, page_last, stats);
+
+		tbb::task_arena arena(settings.num_threads > 0 ? (int)settings.num_threads : tbb::task_arena::automatic);
+		arena.execute([&]
+			{
+				tbb::parallel_reduce(reader.slabs(), reader);
+			});
+
+		if (!reader.ok)
+			return nullptr;
+
+		// The scan of a multi-page TIFF stops at the region, so the stack does not know the page count of the file
+		std::cout << "Loaded pages " << page_first << " - " << (int)page_last - 1 << " (" << reader.width << " , " << reader.height << ")" << std::endl;
+		std::cout << "Max value found: " << reader.max_val << std::endl;
+
+		if (stats)
+		{
+			*stats = reader.stats;
+			stats->threshold = settings.threshold;
+			stats->variance = stats->total_count > 0 ? stats->m2 / (double)stats->total_count : 0.0;
+
+			if (settings.verbose)
+			{
+				std::cout << "Values: " << stats->total_count << " (" << stats->active_count << " active)" << std::endl;
+				std::cout << "Range: " << stats->min << " - " << stats->max << std::endl;
+				std::cout << "Mean: " << stats->mean << " Variance: " << stats->variance << std::endl;
+			}
+		}
+
+		if (region)
+			*region = reader.region;
+
+		return reader.tree;
+	}
+
+	// Read the pages of a stack into a scalar or vector grid.
+	template<typename ValueT>
+	static typename Grid<ValueT>::Ptr load_tiff_stack(const TiffStack& stack, const TiffReadSettings& stack_settings, TiffReadStats* stats)
+	{
+		using GridT = typename Grid<ValueT>::GridT;
+
+		TiffReadSettings settings = stack_settings;
+
+		try
+		{
+			typename GridT::TreeType::Ptr tree = read_stack_tree<ValueT>(stack, settings, stats);
+			if (!tree)
+				return typename Grid<ValueT>::Ptr(nullptr);
+
+			typename GridT::Ptr grid = GridT::create(tree);
+
+			grid->setGridClass(openvdb::GRID_FOG_VOLUME);
+			grid->setName(TiffValue<ValueT>::name());
+			grid->pruneGrid(settings.threshold);
+
+			// Scale the slices apart, and place every reduced voxel at the center of
+			// the pixels it averages
+			if (settings.reduction > 1 || settings.z_spacing != 1.0)
+			{
+				double f = settings.reduction;
+				double dz = settings.z_spacing;
+
+				openvdb::math::Transform::Ptr xform = openvdb::math::Transform::createLinearTransform(1.0);
+				xform->postScale(openvdb::Vec3d(f, f, f * dz));
+				xform->postTranslate(openvdb::Vec3d(0.5 * (f - 1.0), 0.5 * (f - 1.0), 0.5 * (f - 1.0) * dz));
+				grid->setTransform(xform);
+			}
+
+			auto ds_grid = std::make_shared<Grid<ValueT>>();
+			ds_grid->m_grid = grid;
+
+			return ds_grid;
+		}
+		catch (std::exception e)
+		{
+			std::cout << e.what() << std::endl;
+			return typename Grid<ValueT>::Ptr(nullptr);
+		}
+	}
+
+	// Collect the pages of a multi-page TIFF. The directory offsets are scanned once,
+	// so that every task can jump straight to its pages. Every directory is parsed on
+	// the way, so the scan stops after the last page of the region of the settings.
+	static bool scan_tiff_pages(const std::string path, TiffStack& stack, const TiffReadSettings& settings)
+	{
+		TIFF* tif = TIFFOpen(path.c_str(), "r");
+
+		if (!tif)
+		{
+			std::cerr << "Failed to load multi-page TIFF" << std::endl;
+			return false;
+		}
+
+		stack.files.assign(1, path);
+		stack.pages.clear();
+
+		size_t max_pages = std::numeric_limits<size_t>::max();
+		if (!settings.bbox.empty())
+			max_pages = (size_t)std::max(settings.bbox.max().z() + 1, 1);
+
+		do {
+			stack.pages.push_back({ 0, TIFFCurrentDirOffset(tif) });
+		} while (stack.pages.size() < max_pages && TIFFReadDirectory(tif));
+
+		TIFFClose(tif);
+
+		return true;
+	}
 
-		if (!verbose)
+	Grid<float>::Ptr load_scalar_tiff(const std::string path, const TiffReadSettings& settings, TiffReadStats* stats)
+	{
+		if (settings.verbose)
 		{
 			std::cout << "Opening scalar multi-page TIFF '" << path << "'" << std::endl;
-			std::cout << "Threshold: " << threshold << std::endl;
+			std::cout << "Threshold: " << settings.threshold << std::endl;
+			std::cout << "Reduction: " << settings.reduction << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_pages(path, stack, settings))
+			return Grid<float>::Ptr(nullptr);
+
+		return load_tiff_stack<float>(stack, settings, stats);
+	}
+
+	// Compare file names so that runs of digits are ordered by their value (slice_2 < slice_10).
+	static bool natural_less(const std::string& a, const std::string& b)
+	{
+		size_t i = 0, j = 0;
+
+		while (i < a.size() && j < b.size())
+		{
+			if (isdigit((unsigned char)a[i]) && isdigit((unsigned char)b[j]))
+			{
+				size_t i1 = i, j1 = j;
+				while (i1 < a.size() && a[i1] == '0') ++i1;
+				while (j1 < b.size() && b[j1] == '0') ++j1;
+
+				size_t i2 = i1, j2 = j1;
+				while (i2 < a.size() && isdigit((unsigned char)a[i2])) ++i2;
+				while (j2 < b.size() && isdigit((unsigned char)b[j2])) ++j2;
+
+				// Longer runs without leading zeros are larger numbers
+				if (i2 - i1 != j2 - j1)
+					return i2 - i1 < j2 - j1;
+
+				int cmp = a.compare(i1, i2 - i1, b, j1, j2 - j1);
+				if (cmp != 0)
+					return cmp < 0;
+
+				i = i2;
+				j = j2;
+				continue;
+			}
+
+			int ca = tolower((unsigned char)a[i]), cb = tolower((unsigned char)b[j]);
+			if (ca != cb)
+				return ca < cb;
+
+			++i;
+			++j;
+		}
+
+		return a.size() - i < b.size() - j;
+	}
+
+	// Match a file name against a pattern with * and ? wildcards, ignoring case.
+	static bool wildcard_match(const char* pattern, const char* name)
+	{
+		if (*pattern == '\0')
+			return *name == '\0';
+
+		if (*pattern == '*')
+			return wildcard_match(pattern + 1, name) || (*name != '\0' && wildcard_match(pattern, name + 1));
+
+		if (*name == '\0')
+			return false;
+
+		if (*pattern != '?' && tolower((unsigned char)*pattern) != tolower((unsigned char)*name))
+			return false;
+
+		return wildcard_match(pattern + 1, name + 1);
+	}
+
+	std::vector<std::string> list_tiff_sequence(const std::string pattern)
+	{
+		namespace fs = std::filesystem;
+
+		std::vector<std::string> files;
+
+		fs::path dir(pattern), mask;
+		std::error_code ec;
+
+		if (!fs::is_directory(dir, ec))
+		{
+			mask = dir.filename();
+			dir = dir.parent_path();
+			if (dir.empty())
+				dir = ".";
+		}
+
+		for (const auto& entry : fs::directory_iterator(dir, ec))
+		{
+			if (!entry.is_regular_file(ec))
+				continue;
+
+			std::string name = entry.path().filename().string();
+
+			if (mask.empty())
+			{
+				if (!wildcard_match("*.tif", name.c_str()) && !wildcard_match("*.tiff", name.c_str()))
+					continue;
+			}
+			else if (!wildcard_match(mask.string().c_str(), name.c_str()))
+				continue;
+
+			files.push_back(entry.path().string());
+		}
+
+		if (ec)
+			std::cerr << "Could not list '" << pattern << "': " << ec.message() << std::endl;
+
+		std::sort(files.begin(), files.end(), [](const std::string& a, const std::string& b)
+			{
+				return natural_less(fs::path(a).filename().string(), fs::path(b).filename().string());
+			});
+
+		return files;
+	}
+
+	// Collect the first directory of every file of a directory or pattern as one page.
+	static bool scan_tiff_sequence(const std::string pattern, TiffStack& stack)
+	{
+		stack.files = list_tiff_sequence(pattern);
+		stack.pages.clear();
+
+		if (stack.files.empty())
+		{
+			std::cerr << "Found no TIFF files matching '" << pattern << "'" << std::endl;
+			return false;
+		}
+
+		// Files are only opened by the ingest tasks, so that many of them are opened
+		// and decoded at the same time.
+		for (unsigned int i = 0; i < stack.files.size(); ++i)
+			stack.pages.push_back({ i, 0 });
+
+		return true;
+	}
+
+	Grid<float>::Ptr load_scalar_tiff_sequence(const std::string pattern, const TiffReadSettings& settings, TiffReadStats* stats)
+	{
+		if (settings.verbose)
+		{
+			std::cout << "Opening TIFF sequence '" << pattern << "'" << std::endl;
+			std::cout << "Threshold: " << settings.threshold << std::endl;
+			std::cout << "Reduction: " << settings.reduction << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_sequence(pattern, stack))
+			return Grid<float>::Ptr(nullptr);
+
+		return load_tiff_stack<float>(stack, settings, stats);
+	}
+
+	Grid<openvdb::Vec3f>::Ptr load_vector_tiff(const std::string path, double threshold, unsigned int crop)
+	{
+		TiffReadSettings settings;
+		settings.threshold = threshold;
+		settings.crop = crop;
+
+		return load_vector_tiff(path, settings);
+	}
+
+	Grid<openvdb::Vec3f>::Ptr load_vector_tiff(const std::string path, const TiffReadSettings& settings, TiffReadStats* stats)
+	{
+		if (settings.verbose)
+		{
+			std::cout << "Opening vector multi-page TIFF '" << path << "'" << std::endl;
+			std::cout << "Threshold: " << settings.threshold << std::endl;
+			std::cout << "Reduction: " << settings.reduction << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_pages(path, stack, settings))
+			return Grid<openvdb::Vec3f>::Ptr(nullptr);
+
+		return load_tiff_stack<openvdb::Vec3f>(stack, settings, stats);
+	}
+
+	Grid<openvdb::Vec3f>::Ptr load_vector_tiff_sequence(const std::string pattern, const TiffReadSettings& settings, TiffReadStats* stats)
+	{
+		if (settings.verbose)
+		{
+			std::cout << "Opening vector TIFF sequence '" << pattern << "'" << std::endl;
+			std::cout << "Threshold: " << settings.threshold << std::endl;
+			std::cout << "Reduction: " << settings.reduction << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_sequence(pattern, stack))
+			return Grid<openvdb::Vec3f>::Ptr(nullptr);
+
+		return load_tiff_stack<openvdb::Vec3f>(stack, settings, stats);
+	}
+
+	// Collect the pages of a multi-page TIFF, or of a directory or pattern of slices.
+	static bool scan_tiff_input(const std::string path, TiffStack& stack, const TiffReadSettings& settings)
+	{
+		std::error_code ec;
+		bool is_sequence = std::filesystem::is_directory(path, ec) || path.find_first_of("*?") != std::string::npos;
+
+		return is_sequence ? scan_tiff_sequence(path, stack) : scan_tiff_pages(path, stack, settings);
+	}
+
+	// Load a multi-page TIFF, or a directory or pattern of slices, into a scalar or vector grid.
+	template<typename ValueT>
+	static typename Grid<ValueT>::Ptr load_tiff_input(const std::string path, const TiffReadSettings& settings, TiffReadStats* stats)
+	{
+		if (settings.verbose)
+		{
+			std::cout << "Opening TIFF '" << path << "'" << std::endl;
+			std::cout << "Threshold: " << settings.threshold << std::endl;
+			std::cout << "Reduction: " << settings.reduction << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_input(path, stack, settings))
+			return typename Grid<ValueT>::Ptr(nullptr);
+
+		return load_tiff_stack<ValueT>(stack, settings, stats);
+	}
+
+	// File of band n of a conversion to out_path, e.g. out_0003.vdb for out.vdb.
+	static std::filesystem::path tiff_band_path(const std::filesystem::path& out_path, int n)
+	{
+		std::string extension = out_path.has_extension() ? out_path.extension().string() : ".vdb";
+
+		std::ostringstream name;
+		name << out_path.stem().string() << "_" << std::setw(4) << std::setfill('0') << n << extension;
+
+		return out_path.parent_path() / name.str();
+	}
+
+	int convert_tiff_to_vdb(const std::string path, const std::string out_path, const TiffReadSettings& settings, unsigned int band_pages, bool float_as_half, TiffReadStats* stats)
+	{
+		namespace fs = std::filesystem;
+
+		if (settings.verbose)
+		{
+			std::cout << "Converting TIFF '" << path << "' to '" << out_path << "'" << std::endl;
+			std::cout << "Pages per band: " << band_pages << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_input(path, stack, settings))
+			return -1;
+
+		if (settings.reduction < 1)
+		{
+			std::cerr << "Reduction factor has to be at least 1" << std::endl;
+			return -1;
+		}
+
+		unsigned int page_first, page_last;
+		stack_page_range(stack, settings, page_first, page_last);
+
+		// The threshold is chosen once for the whole region, so that all bands agree
+		TiffReadSettings band_settings = settings;
+		if (!choose_threshold<float>(stack, band_settings, page_first, page_last))
+			return -1;
+
+		band_settings.threshold_mode = TiffReadSettings::THRESHOLD_FIXED;
+
+		// Bands are whole slabs, so that no leaf is split between two files
+		unsigned int slab_pages = TIFF_SLAB_DEPTH * settings.reduction;
+		band_pages = std::max((band_pages + slab_pages - 1) / slab_pages, 1u) * slab_pages;
+
+		if (band_settings.bbox.empty())
+			band_settings.bbox = openvdb::CoordBBox(openvdb::Coord(0), openvdb::Coord(std::numeric_limits<int>::max() - 1));
+
+		TiffReadStats total;
+		if (stats)
+		{
+			total.hist_min = stats->hist_min;
+			total.hist_max = stats->hist_max;
+		}
+
+		fs::path out(out_path);
+
+		int num_bands = 0;
+		for (unsigned int z0 = page_first / band_pages * band_pages; z0 < page_last; z0 += band_pages, ++num_bands)
+		{
+			band_settings.bbox.min().z() = (int)std::max(z0, page_first);
+			band_settings.bbox.max().z() = (int)std::min(z0 + band_pages, page_last) - 1;
+
+			TiffReadStats band_stats;
+			band_stats.hist_min = total.hist_min;
+			band_stats.hist_max = total.hist_max;
+
+			Grid<float>::Ptr band = load_tiff_stack<float>(stack, band_settings, stats ? &band_stats : nullptr);
+			if (!band)
+				return -1;
+
+			if (stats)
+				total.merge(band_stats);
+
+			fs::path band_path = tiff_band_path(out, num_bands);
+
+			openvdb::io::File file(band_path.string());
+			file.setCompression(openvdb::io::COMPRESS_ACTIVE_MASK | openvdb::io::COMPRESS_BLOSC);
+
+			band->m_grid->setSaveFloatAsHalf(float_as_half);
+			file.write(openvdb::GridPtrVec{ band->m_grid });
+			file.close();
+
+			std::cout << "Wrote pages " << band_settings.bbox.min().z() << " - " << band_settings.bbox.max().z() << " to " << band_path.filename().string() << std::endl;
+		}
+
+		if (stats)
+		{
+			*stats = total;
+			stats->threshold = band_settings.threshold;
+		}
+
+		return num_bands;
+	}
+
+	// Combine the active voxels of source with the voxels of target, in place.
+	static void blend_leaf(FloatLeafT& target, const FloatLeafT& source, TiffBlendMode blend)
+	{
+		for (auto iter = source.cbeginValueOn(); iter; ++iter)
+		{
+			openvdb::Index n = iter.pos();
+			float val = *iter;
+
+			if (target.isValueOn(n))
+			{
+				if (blend == BLEND_MAX)
+					val = std::max(val, target.getValue(n));
+				else if (blend == BLEND_AVERAGE)
+					val = 0.5f * (val + target.getValue(n));
+			}
+
+			target.setValueOn(n, val);
+		}
+	}
+
+	// Move the leaves of source into target. Leaves that target already has are blended
+	// in parallel, the others are attached whole.
+	static void blend_tree(FloatTreeT& target, FloatTreeT& source, TiffBlendMode blend)
+	{
+		std::vector<FloatLeafT*> leaves;
+		source.stealNodes(leaves);
+
+		std::vector<char> blended(leaves.size(), 0);
+
+		// Probing and writing existing leaves leaves the topology of target alone
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, leaves.size()), [&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t n = range.begin(); n < range.end(); ++n)
+				{
+					FloatLeafT* existing = target.probeLeaf(leaves[n]->origin());
+					if (!existing)
+						continue;
+
+					blend_leaf(*existing, *leaves[n], blend);
+					blended[n] = 1;
+				}
+			});
+
+		for (size_t n = 0; n < leaves.size(); ++n)
+		{
+			std::unique_ptr<FloatLeafT> leaf(leaves[n]);
+			if (blended[n])
+				continue;
+
+			// Active tiles are turned into a leaf to blend with, anything else is replaced
+			if (target.isValueOn(leaf->origin()))
+				blend_leaf(*target.touchLeaf(leaf->origin()), *leaf, blend);
+			else
+				target.addLeaf(leaf.release());
+		}
+	}
+
+	int append_scalar_tiff(openvdb::FloatGrid& grid, const std::string path, const TiffReadSettings& settings, TiffBlendMode blend, TiffReadStats* stats)
+	{
+		if (settings.verbose)
+		{
+			std::cout << "Appending TIFF '" << path << "' at " << settings.offset << std::endl;
+			std::cout << "Threshold: " << settings.threshold << std::endl;
+			std::cout << "Reduction: " << settings.reduction << std::endl;
+		}
+
+		TiffStack stack;
+		if (!scan_tiff_input(path, stack, settings))
+			return -1;
+
+		TiffReadSettings append_settings = settings;
+
+		unsigned int page_first, page_last;
+		stack_page_range(stack, append_settings, page_first, page_last);
+
+		try
+		{
+			openvdb::CoordBBox region;
+			FloatTreeT::Ptr tree = read_stack_tree<float>(stack, append_settings, stats, &region);
+			if (!tree)
+				return -1;
+
+			// Clear the region of the pages, so that voxels below the threshold replace the old ones too
+			if (blend == BLEND_OVERWRITE && !region.empty())
+				grid.tree().fill(region, grid.background(), false);
+
+			blend_tree(grid.tree(), *tree, blend);
+
+			return (int)(page_last - page_first);
+		}
+		catch (std::exception e)
+		{
+			std::cout << e.what() << std::endl;
+			return -1;
 		}
+	}
+
+#pragma endregion TIFF_ingest
+
+#pragma region Raw_ingest
 
-		using TreeT = openvdb::tree::Tree< openvdb::tree::RootNode< openvdb::tree::InternalNode< openvdb::tree::InternalNode< openvdb::tree::LeafNode< float, 3 >, 4 >, 5 >>>;
-		using GridT = openvdb::Grid<TreeT>;
-		using ValueT = typename GridT::ValueType;
+	// Body for tbb::parallel_reduce over the leaf rows of a mapped volume. Leaf row b
+	// is the row of leaves starting at y = (b % rows_y) * 8 and z = (b / rows_y) * 8.
+	// Its samples are walked in file order and written into one leaf per 8 columns,
+	// so that the mapping is read sequentially and never copied.
+	template<typename SampleT>
+	struct RawVolumeReader
+	{
+		const uint8_t* data;
+		const RawVolumeInfo& info;
+		float scale;
+		double threshold;
+		uint32_t rows_y;
 
-		typename GridT::Ptr grid = GridT::create();
+		FloatTreeT::Ptr tree;
 
-		typename GridT::Accessor accessor = (*grid).getAccessor();
+		// Leaves of the current leaf row. Leaves that stay empty are recycled.
+		std::vector<std::unique_ptr<FloatLeafT>> leaves;
 
-		openvdb::Coord ijk;
-		int& i = ijk[0], & j = ijk[1], & k = ijk[2];
+		RawVolumeReader(const uint8_t* data, const RawVolumeInfo& info, float scale, double threshold)
+			: data(data), info(info), scale(scale), threshold(threshold)
+			, rows_y((info.height + FloatLeafT::DIM - 1) / FloatLeafT::DIM)
+			, tree(new FloatTreeT(0.0f)), leaves((info.width + FloatLeafT::DIM - 1) / FloatLeafT::DIM)
+		{
+		}
 
-		TIFF* tif = TIFFOpen(path.c_str(), "r");
+		RawVolumeReader(RawVolumeReader& other, tbb::split)
+			: RawVolumeReader(other.data, other.info, other.scale, other.threshold)
+		{
+		}
 
-		if (tif) {
-			try
-			{
-				unsigned int width, height, samplesperpixel, bitspersample;
-				ValueT max_val = 0.0;
+		void operator()(const tbb::blocked_range<uint64_t>& range)
+		{
+			const size_t row_bytes = (size_t)info.width * sizeof(SampleT);
+			const size_t plane_bytes = row_bytes * info.height;
 
-				do {
-					uint32_t* raster;
+			for (uint64_t b = range.begin(); b != range.end(); ++b)
+			{
+				uint32_t y0 = (uint32_t)(b % rows_y) * FloatLeafT::DIM;
+				uint32_t z0 = (uint32_t)(b / rows_y) * FloatLeafT::DIM;
 
-					// get the size of the tiff
-					TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
-					TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
-					TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
-					TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
+				uint32_t ny = std::min(info.height - y0, (uint32_t)FloatLeafT::DIM);
+				uint32_t nz = std::min(info.depth - z0, (uint32_t)FloatLeafT::DIM);
 
-					if (verbose)
-					{
-						std::cout << "frame " << k << std::endl;
-						std::cout << "    width: " << width << std::endl;
-						std::cout << "    height: " << height << std::endl;
-						std::cout << "    samplesperpixel: " << samplesperpixel << std::endl;
-						std::cout << "    bitspersample: " << bitspersample << std::endl;
-					}
+				for (size_t l = 0; l < leaves.size(); ++l)
+				{
+					openvdb::Coord origin((int)(l * FloatLeafT::DIM), (int)y0, (int)z0);
 
-					unsigned int npixels = width * height; // get the total number of pixels
+					if (!leaves[l])
+						leaves[l].reset(new FloatLeafT(origin, 0.0f, false));
+					else
+						leaves[l]->setOrigin(origin);
+				}
 
-					raster = (uint32_t*)_TIFFmalloc(npixels * sizeof(uint32_t)); // allocate temp memory (must use the tiff library malloc)
-					if (raster == NULL) // check the raster's memory was allocaed
+				for (uint32_t dz = 0; dz < nz; ++dz)
+				{
+					for (uint32_t r = 0; r < ny; ++r)
 					{
-						TIFFClose(tif);
-						std::cerr << "Could not allocate memory for raster of TIFF image" << std::endl;
-						return std::shared_ptr<Grid<ValueT>>(nullptr);
-					}
+						const uint8_t* row = data + (z0 + dz) * plane_bytes + (y0 + r) * row_bytes;
 
-					// Check the tif read to the raster correctly
-					if (!TIFFReadRGBAImage(tif, width, height, raster, 0))
-					{
-						TIFFClose(tif);
-						std::cerr << "Could not read raster of TIFF image" << std::endl;
-						return std::shared_ptr<Grid<ValueT>>(nullptr);
-					}
-					if (crop_x > width)
-						crop_x = 0;
-					if (crop_y > height)
-						crop_y = 0;
-
-					// itterate through all the pixels of the tif
-					for (i = 0; (unsigned int)i < width; i++)
-						for (j = 0; (unsigned int)j < height; j++)
+						for (uint32_t x = 0; x < info.width; ++x)
 						{
-							uint32_t& TiffPixel = raster[j * width + i]; // read the current pixel of the TIF
-
-							ValueT val = ValueT(((float)(TIFFGetR(TiffPixel) + TIFFGetG(TiffPixel) + TIFFGetB(TiffPixel))) / (255. * 3));
-							max_val = std::max(max_val, val);
+							// The header may leave the samples unaligned
+							SampleT sample;
+							std::memcpy(&sample, row + (size_t)x * sizeof(SampleT), sizeof(SampleT));
 
+							float val = (float)sample * scale;
 							if (val < threshold)
 								continue;
 
-							//j = height-true_j - 1;
-
-							accessor.setValue(ijk, val);
-
+							openvdb::Index offset = ((x & (FloatLeafT::DIM - 1)) << (2 * FloatLeafT::LOG2DIM)) + (r << FloatLeafT::LOG2DIM) + dz;
+							leaves[x >> FloatLeafT::LOG2DIM]->setValueOn(offset, val);
 						}
+					}
+				}
 
-					_TIFFfree(raster); // release temp memory
+				for (auto& leaf : leaves)
+					if (!leaf->isEmpty())
+						tree->addLeaf(leaf.release());
+			}
+		}
 
-					k++;
+		void join(RawVolumeReader& other)
+		{
+			tree->merge(*other.tree);
+		}
+	};
 
-				} while (TIFFReadDirectory(tif)); // get the next tif
-				TIFFClose(tif); // close the tif file
+	template<typename SampleT>
+	static FloatTreeT::Ptr read_raw_tree(const uint8_t* data, const RawVolumeInfo& info, float scale, double threshold, unsigned int num_threads)
+	{
+		RawVolumeReader<SampleT> reader(data, info, scale, threshold);
+		uint64_t num_rows = (uint64_t)reader.rows_y * ((info.depth + FloatLeafT::DIM - 1) / FloatLeafT::DIM);
 
-				std::cout << "Loaded " << k << " pages (" << width << " , " << height << ")" << std::endl;
-				std::cout << "Max value found: " << max_val << std::endl;
+		tbb::task_arena arena(num_threads > 0 ? (int)num_threads : tbb::task_arena::automatic);
+		arena.execute([&]
+			{
+				tbb::parallel_reduce(tbb::blocked_range<uint64_t>(0, num_rows), reader);
+			});
 
-				grid->setGridClass(openvdb::GRID_FOG_VOLUME);
-				grid->setName("density");
-				grid->pruneGrid(threshold);
+		return reader.tree;
+	}
 
-				auto ds_grid = std::make_shared<Grid<ValueT>>();
-				ds_grid->m_grid = grid;
+	static std::string trim(const std::string& str)
+	{
+		size_t begin = str.find_first_not_of(" \t\r\n");
+		if (begin == std::string::npos)
+			return std::string();
 
-				return ds_grid;
-			}
-			catch (std::exception e)
-			{
-				std::cout << e.what() << std::endl;
-				return Grid<ValueT>::Ptr(nullptr);
-			}
-		}
-		else
-		{
-			std::cerr << "Failed to load multi-page TIFF" << std::endl;
-			return Grid<ValueT>::Ptr(nullptr);
-		}
+		return str.substr(begin, str.find_last_not_of(" \t\r\n") - begin + 1);
 	}
 
-	std::shared_ptr<Grid<openvdb::Vec3f>> load_vector_tiff(const std::string path, double threshold, unsigned int crop)
+	bool read_raw_header(const std::string path, RawVolumeInfo& info, std::string& data_path)
 	{
-		bool verbose = false;
-		unsigned int crop_x = crop, crop_y = crop;
-
-		if (verbose)
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
 		{
-			std::cout << "Opening vector multi-page TIFF '" << path << "'" << std::endl;
-			std::cout << "Threshold: " << threshold << std::endl;
+			std::cerr << "Could not open MetaImage header '" << path << "'" << std::endl;
+			return false;
 		}
 
-		using TreeT = openvdb::tree::Tree< openvdb::tree::RootNode< openvdb::tree::InternalNode< openvdb::tree::InternalNode< openvdb::tree::LeafNode< openvdb::Vec3f, 3 >, 4 >, 5 >>>;
-		using GridT = openvdb::Grid<TreeT>;
-		using ValueT = typename GridT::ValueType;
+		info = RawVolumeInfo();
+		data_path.clear();
 
-		typename GridT::Ptr grid = GridT::create();
+		int64_t header_size = 0;
+		std::string line;
 
-		typename GridT::Accessor accessor = (*grid).getAccessor();
+		while (std::getline(in, line))
+		{
+			size_t eq = line.find('=');
+			if (eq == std::string::npos)
+				continue;
 
-		openvdb::Coord ijk;
-		int& i = ijk[0], & j = ijk[1], & k = ijk[2];
+			std::string key = trim(line.substr(0, eq));
+			std::string value = trim(line.substr(eq + 1));
+			std::istringstream values(value);
 
-		TIFF* tif = TIFFOpen(path.c_str(), "r");
+			if (key == "DimSize")
+			{
+				std::vector<uint32_t> dims;
+				for (uint32_t dim; values >> dim;)
+					dims.push_back(dim);
 
-		if (tif) {
-			unsigned int width, height, samplesperpixel, bitspersample;
-			ValueT max_val = openvdb::Vec3f(0,0,0);
+				info.width = dims.size() > 0 ? dims[0] : 0;
+				info.height = dims.size() > 1 ? dims[1] : 1;
+				info.depth = dims.size() > 2 ? dims[2] : 1;
+			}
+			else if (key == "ElementSpacing" || key == "ElementSize")
+			{
+				for (int i = 0; i < 3 && values >> info.spacing[i]; ++i);
+			}
+			else if (key == "ElementType")
+			{
+				if (value == "MET_UCHAR")
+					info.sample_type = RawVolumeInfo::RAW_UINT8;
+				else if (value == "MET_USHORT")
+					info.sample_type = RawVolumeInfo::RAW_UINT16;
+				else if (value == "MET_FLOAT")
+					info.sample_type = RawVolumeInfo::RAW_FLOAT32;
+				else
+				{
+					std::cerr << "Unsupported element type " << value << std::endl;
+					return false;
+				}
+			}
+			else if (key == "ElementNumberOfChannels" && value != "1")
+			{
+				std::cerr << "Only volumes with one channel are supported" << std::endl;
+				return false;
+			}
+			else if ((key == "BinaryDataByteOrderMSB" || key == "ElementByteOrderMSB") && value == "True")
+			{
+				std::cerr << "Only little-endian volumes are supported" << std::endl;
+				return false;
+			}
+			else if (key == "HeaderSize")
+				values >> header_size;
+			else if (key == "ElementDataFile")
+			{
+				// Always the last field. LOCAL data follows the header in the same file.
+				if (value == "LOCAL")
+				{
+					data_path = path;
+					header_size = (int64_t)in.tellg();
+				}
+				else
+					data_path = (std::filesystem::path(path).parent_path() / value).string();
 
-			do {
-				uint32_t* raster;
+				break;
+			}
+		}
 
-				// get the size of the tiff
-				TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
-				TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
-				TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
-				TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
+		if (data_path.empty() || info.width == 0)
+		{
+			std::cerr << "MetaImage header '" << path << "' has no DimSize or ElementDataFile" << std::endl;
+			return false;
+		}
 
-				if (verbose)
-				{
-					std::cout << "frame " << k << std::endl;
-					std::cout << "    width: " << width << std::endl;
-					std::cout << "    height: " << height << std::endl;
-					std::cout << "    samplesperpixel: " << samplesperpixel << std::endl;
-					std::cout << "    bitspersample: " << bitspersample << std::endl;
-				}
+		// A header size of -1 places the samples at the end of the file
+		if (header_size < 0)
+		{
+			static const uint64_t sample_bytes[] = { 1, 2, 4 };
+			uint64_t data_bytes = (uint64_t)info.width * info.height * info.depth * sample_bytes[info.sample_type];
 
-				unsigned int npixels = width * height; // get the total number of pixels
+			std::error_code error;
+			uint64_t file_size = std::filesystem::file_size(data_path, error);
+			header_size = !error && file_size > data_bytes ? (int64_t)(file_size - data_bytes) : 0;
+		}
 
-				raster = (uint32_t*)_TIFFmalloc(npixels * sizeof(uint32_t)); // allocate temp memory (must use the tiff library malloc)
-				if (raster == NULL) // check the raster's memory was allocaed
-				{
-					TIFFClose(tif);
-					std::cerr << "Could not allocate memory for raster of TIFF image" << std::endl;
-					return std::shared_ptr<Grid<ValueT>>(nullptr);
-				}
+		info.header_bytes = (uint64_t)header_size;
 
-				// Check the tif read to the raster correctly
-				if (!TIFFReadRGBAImage(tif, width, height, raster, 0))
-				{
-					TIFFClose(tif);
-					std::cerr << "Could not read raster of TIFF image" << std::endl;
-					return std::shared_ptr<Grid<ValueT>>(nullptr);
-				}
-				if (crop_x > width)
-					crop_x = 0;
-				if (crop_y > height)
-					crop_y = 0;
-
-				// itterate through all the pixels of the tif
-				for (i = crop_x; (unsigned int)i < width - crop_x; i++)
-					for (j = crop_y; (unsigned int)j < height - crop_y; j++)
-					{
-						uint32_t& TiffPixel = raster[j * width + i]; // read the current pixel of the TIF
+		return true;
+	}
 
-						ValueT val = ValueT(
-							(float)TIFFGetR(TiffPixel) / 255. - 0.5,
-							(float)TIFFGetR(TiffPixel) / 255. - 0.5,
-							(float)TIFFGetR(TiffPixel) / 255. - 0.5
-							
-							);
-						max_val = std::max(max_val, val);
+	Grid<float>::Ptr load_raw_volume(const std::string path, const RawVolumeInfo& info, double threshold, unsigned int num_threads, bool verbose)
+	{
+		using GridT = Grid<float>::GridT;
 
-						if (val.length() < threshold)
-							continue;
+		static const uint64_t sample_bytes[] = { 1, 2, 4 };
+		if (info.sample_type < RawVolumeInfo::RAW_UINT8 || info.sample_type > RawVolumeInfo::RAW_FLOAT32)
+		{
+			std::cerr << "Unsupported raw sample type" << std::endl;
+			return Grid<float>::Ptr(nullptr);
+		}
 
-						accessor.setValue(ijk, val);
+		if (verbose)
+		{
+			std::cout << "Opening raw volume '" << path << "'" << std::endl;
+			std::cout << "    size: " << info.width << " x " << info.height << " x " << info.depth << std::endl;
+			std::cout << "    bytes per sample: " << sample_bytes[info.sample_type] << std::endl;
+			std::cout << "    header bytes: " << info.header_bytes << std::endl;
+		}
 
-					}
+		MappedFile file;
+		if (!file.open(path))
+		{
+			std::cerr << "Failed to map raw volume '" << path << "'" << std::endl;
+			return Grid<float>::Ptr(nullptr);
+		}
 
-				_TIFFfree(raster); // release temp memory
+		uint64_t data_bytes = (uint64_t)info.width * info.height * info.depth * sample_bytes[info.sample_type];
+		if (file.size() < info.header_bytes + data_bytes)
+		{
+			std::cerr << "Raw volume is " << file.size() << " bytes, expected at least " << info.header_bytes + data_bytes << std::endl;
+			return Grid<float>::Ptr(nullptr);
+		}
 
-				k++;
+		try
+		{
+			const uint8_t* data = file.data() + info.header_bytes;
+			FloatTreeT::Ptr tree;
 
-			} while (TIFFReadDirectory(tif)); // get the next tif
-			TIFFClose(tif); // close the tif file
+			switch (info.sample_type)
+			{
+			case RawVolumeInfo::RAW_UINT8:
+				tree = read_raw_tree<uint8_t>(data, info, 1.0f / 255.0f, threshold, num_threads);
+				break;
+			case RawVolumeInfo::RAW_UINT16:
+				tree = read_raw_tree<uint16_t>(data, info, 1.0f / 65535.0f, threshold, num_threads);
+				break;
+			default:
+				tree = read_raw_tree<float>(data, info, 1.0f, threshold, num_threads);
+				break;
+			}
 
-			std::cout << "Loaded " << k << " pages (" << width << " , " << height << ")" << std::endl;
-			std::cout << "Max value found: " << max_val << std::endl;
+			GridT::Ptr grid = GridT::create(tree);
 
 			grid->setGridClass(openvdb::GRID_FOG_VOLUME);
-			grid->setName("tiff");
+			grid->setName("density");
+			grid->pruneGrid(threshold);
 
-			auto ds_grid = std::make_shared<Grid<ValueT>>();
+			if (info.spacing[0] > 0.0 && (info.spacing[1] != info.spacing[0] || info.spacing[2] != info.spacing[0]))
+			{
+				openvdb::math::Transform::Ptr xform = openvdb::math::Transform::createLinearTransform(1.0);
+				xform->postScale(openvdb::Vec3d(1.0, info.spacing[1] / info.spacing[0], info.spacing[2] / info.spacing[0]));
+				grid->setTransform(xform);
+			}
+
+			std::cout << "Loaded raw volume (" << info.width << " , " << info.height << " , " << info.depth << ")" << std::endl;
+
+			auto ds_grid = std::make_shared<Grid<float>>();
 			ds_grid->m_grid = grid;
 
 			return ds_grid;
 		}
-		else
+		catch (std::exception e)
 		{
-			std::cerr << "Failed to load multi-page TIFF" << std::endl;
-			return std::shared_ptr<Grid<ValueT>>(nullptr);
+			std::cout << e.what() << std::endl;
+			return Grid<float>::Ptr(nullptr);
 		}
 	}
 
+	Grid<float>::Ptr load_raw_volume(const std::string header_path, double threshold, unsigned int num_threads, bool verbose)
+	{
+		RawVolumeInfo info;
+		std::string data_path;
+
+		if (!read_raw_header(header_path, info, data_path))
+			return Grid<float>::Ptr(nullptr);
+
+		return load_raw_volume(data_path, info, threshold, num_threads, verbose);
+	}
+
+#pragma endregion Raw_ingest
+
 	void read_pith(TIFF* tif, RawLam::InfoLog::Ptr infolog, uint32_t height)
 	{
 		uint16_t s, nsamples;
@@ -292,31 +1777,34 @@ namespace DeepSight
 		//std::cout << "Found " << infolog->knots.size() << " knots." << std::endl;
 	}
 	
-	void read_border(TIFF* tif, RawLam::InfoLog::Ptr infolog, uint32_t height, uint32_t width)
+	// Outline pages hold two rows per outline, x then y, of width points each
+	void read_outlines(TIFF* tif, RawLam::OutlineSet& outlines, uint32_t height, uint32_t width)
 	{
 		uint16_t s, nsamples;
 		tdata_t bufx = _TIFFmalloc(TIFFScanlineSize(tif));
 		tdata_t bufy = _TIFFmalloc(TIFFScanlineSize(tif));
 
-		int16_t* datax, *datay;
+		int16_t* datax, * datay;
 		TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
+
+		outlines.points.reserve(outlines.points.size() + (size_t)nsamples * (height / 2) * width);
+		outlines.offsets.reserve(outlines.offsets.size() + (size_t)nsamples * (height / 2));
+
 		for (s = 0; s < nsamples; s++)
 		{
-			for (uint32_t row = 0; row < height; row+=2)
+			for (uint32_t row = 0; row + 1 < height; row += 2)
 			{
 				TIFFReadScanline(tif, bufx, row, s);
 				TIFFReadScanline(tif, bufy, row + 1, s);
 				datax = (int16_t*)bufx;
 				datay = (int16_t*)bufy;
 
-				std::vector<Eigen::Vector2f> outline;
-
 				for (uint32_t i = 0; i < width; i += 1)
 				{
-					outline.push_back(Eigen::Vector2f(static_cast<float>(datax[i]), static_cast<float>(datay[i])));
+					outlines.points.push_back(Eigen::Vector2f(static_cast<float>(datax[i]), static_cast<float>(datay[i])));
 				}
 
-				infolog->border.push_back(outline);
+				outlines.end_outline();
 			}
 		}
 
@@ -324,41 +1812,20 @@ namespace DeepSight
 		_TIFFfree(bufy);
 	}
 
-	void read_sapwood(TIFF* tif, RawLam::InfoLog::Ptr infolog, uint32_t height, uint32_t width)
+	RawLam::InfoLog::Ptr load_infolog(const std::string path, bool verbose, bool use_cache)
 	{
-		uint16_t s, nsamples;
-		tdata_t bufx = _TIFFmalloc(TIFFScanlineSize(tif));
-		tdata_t bufy = _TIFFmalloc(TIFFScanlineSize(tif));
-
-		int16_t* datax, * datay;
-		TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
-		for (s = 0; s < nsamples; s++)
+		if (use_cache)
 		{
-			for (uint32_t row = 0; row < height; row += 2)
+			RawLam::InfoLog::Ptr cached = read_infolog_cache(path);
+			if (cached)
 			{
-				TIFFReadScanline(tif, bufx, row, s);
-				TIFFReadScanline(tif, bufy, row + 1, s);
-				datax = (int16_t*)bufx;
-				datay = (int16_t*)bufy;
-
-				std::vector<Eigen::Vector2f> outline;
-
-				for (uint32_t i = 0; i < width; i += 1)
-				{
-					outline.push_back(Eigen::Vector2f(static_cast<float>(datax[i]), static_cast<float>(datay[i])));
-				}
+				if (verbose)
+					std::cout << "Loaded InfoLog cache '" << infolog_cache_path(path) << "'" << std::endl;
 
-				infolog->sapwood.push_back(outline);
+				return cached;
 			}
 		}
 
-		_TIFFfree(bufx);
-		_TIFFfree(bufy);
-	}
-
-
-	RawLam::InfoLog::Ptr load_infolog(const std::string path, bool verbose)
-	{
 		if (verbose)
 		{
 			std::cout << "Opening InfoLog TIFF '" << path << "'" << std::endl;
@@ -434,10 +1901,10 @@ namespace DeepSight
 						read_knots(tif, infolog, height);
 						break;
 					case(mode::SAPWOOD):
-						read_sapwood(tif, infolog, height, width);
+						read_outlines(tif, infolog->sapwood, height, width);
 						break;
 					case(mode::BORDER):
-						read_border(tif, infolog, height, width);
+						read_outlines(tif, infolog->border, height, width);
 						break;
 					default:
 						break;
@@ -452,6 +1919,10 @@ namespace DeepSight
 				if (verbose)
 					std::cout << "Loaded " << num_pages << " pages (" << width << " , " << height << ")" << std::endl;
 
+				// A cache that cannot be written, e.g. next to a read-only TIFF, only costs the next load a parse
+				if (use_cache && !write_infolog_cache(*infolog, path) && verbose)
+					std::cout << "Could not write InfoLog cache '" << infolog_cache_path(path) << "'" << std::endl;
+
 				return infolog;
 			}
 			catch (std::exception e)
@@ -471,6 +1942,7 @@ namespace DeepSight
 	std::vector<GridBase*> read_vdb(const std::string path)
 	{
 		openvdb::initialize();
+		register_quantized_grids();
 
 		openvdb::io::File file(path);
 		file.open();
@@ -498,6 +1970,65 @@ namespace DeepSight
 		return grids;
 	}
 
+	Grid<float>::Ptr read_vdb_bands(const std::string out_path)
+	{
+		namespace fs = std::filesystem;
+
+		openvdb::initialize();
+		register_quantized_grids();
+
+		openvdb::FloatGrid::Ptr merged;
+		int num_bands = 0;
+
+		try
+		{
+			std::error_code ec;
+			fs::path band_path;
+
+			while (fs::is_regular_file(band_path = tiff_band_path(out_path, num_bands), ec))
+			{
+				openvdb::io::File file(band_path.string());
+				file.open();
+
+				openvdb::FloatGrid::Ptr band = file.beginName() != file.endName() ?
+					openvdb::gridPtrCast<openvdb::FloatGrid>(file.readGrid(file.beginName().gridName())) : nullptr;
+				file.close();
+
+				if (!band)
+				{
+					std::cerr << "'" << band_path.string() << "' holds no float grid" << std::endl;
+					return Grid<float>::Ptr(nullptr);
+				}
+
+				// Bands are whole slabs of leaves, so their leaves are moved over without overlap
+				if (merged)
+					merged->tree().merge(band->tree());
+				else
+					merged = band;
+
+				++num_bands;
+			}
+		}
+		catch (std::exception e)
+		{
+			std::cerr << e.what() << std::endl;
+			return Grid<float>::Ptr(nullptr);
+		}
+
+		if (!merged)
+		{
+			std::cerr << "Found no bands of '" << out_path << "'" << std::endl;
+			return Grid<float>::Ptr(nullptr);
+		}
+
+		std::cout << "Merged " << num_bands << " bands of '" << out_path << "'" << std::endl;
+
+		auto grid = std::make_shared<Grid<float>>();
+		grid->m_grid = merged;
+
+		return grid;
+	}
+
 	void ReadWrite_ReadVdb(const char* path, int* num_grids, GridBase** grid_ptrs)
 	{
 		std::vector<GridBase*> grids = read_vdb(path);
@@ -523,6 +2054,161 @@ namespace DeepSight
 		*/
 	}
 
+	// Settings of the arguments shared by the TIFF exports
+	static TiffReadSettings tiff_read_settings(double threshold, int threshold_mode, int crop, int reduction, int* bbox_min, int* bbox_max)
+	{
+		TiffReadSettings settings;
+		settings.threshold_mode = (TiffReadSettings::ThresholdMode)std::min(std::max(threshold_mode, 0), (int)TiffReadSettings::THRESHOLD_PERCENTILE);
+
+		if (settings.threshold_mode == TiffReadSettings::THRESHOLD_PERCENTILE)
+			settings.threshold_percentile = threshold;
+		else
+			settings.threshold = threshold;
+		settings.crop = (unsigned int)std::max(crop, 0);
+		settings.reduction = (unsigned int)std::max(reduction, 1);
+
+		if (bbox_min && bbox_max)
+			settings.bbox = openvdb::CoordBBox(
+				openvdb::Coord(bbox_min[0], bbox_min[1], bbox_min[2]),
+				openvdb::Coord(bbox_max[0], bbox_max[1], bbox_max[2]));
+
+		return settings;
+	}
+
+	GridBase* ReadWrite_ReadTiff(const char* path, double threshold, int threshold_mode, int crop, int reduction, int* bbox_min, int* bbox_max, TiffReadStats* stats)
+	{
+		openvdb::initialize();
+
+		TiffReadSettings settings = tiff_read_settings(threshold, threshold_mode, crop, reduction, bbox_min, bbox_max);
+
+		Grid<float>::Ptr loaded = load_tiff_input<float>(path, settings, stats);
+		if (!loaded)
+			return nullptr;
+
+		auto grid = new GridBase();
+		grid->m_grid = loaded->m_grid;
+
+		return grid;
+	}
+
+	GridBase* ReadWrite_ReadTiffVector(const char* path, double threshold, int threshold_mode, int crop, int reduction, int* bbox_min, int* bbox_max, TiffReadStats* stats)
+	{
+		openvdb::initialize();
+
+		TiffReadSettings settings = tiff_read_settings(threshold, threshold_mode, crop, reduction, bbox_min, bbox_max);
+
+		Grid<openvdb::Vec3f>::Ptr loaded = load_tiff_input<openvdb::Vec3f>(path, settings, stats);
+		if (!loaded)
+			return nullptr;
+
+		auto grid = new GridBase();
+		grid->m_grid = loaded->m_grid;
+
+		return grid;
+	}
+
+	GridBase* ReadWrite_ReadTiffSequence(const char* path, double threshold, int threshold_mode, int crop, int reduction, double z_spacing, int num_threads, int* bbox_min, int* bbox_max, TiffReadStats* stats)
+	{
+		openvdb::initialize();
+
+		if (!(z_spacing > 0.0))
+		{
+			std::cerr << "The spacing of the slices has to be positive" << std::endl;
+			return nullptr;
+		}
+
+		TiffReadSettings settings = tiff_read_settings(threshold, threshold_mode, crop, reduction, bbox_min, bbox_max);
+		settings.z_spacing = z_spacing;
+		settings.num_threads = (unsigned int)std::max(num_threads, 0);
+
+		Grid<float>::Ptr loaded = load_tiff_input<float>(path, settings, stats);
+		if (!loaded)
+			return nullptr;
+
+		auto grid = new GridBase();
+		grid->m_grid = loaded->m_grid;
+
+		return grid;
+	}
+
+	static GridBase* to_grid_base(Grid<float>::Ptr loaded)
+	{
+		if (!loaded)
+			return nullptr;
+
+		auto grid = new GridBase();
+		grid->m_grid = loaded->m_grid;
+
+		return grid;
+	}
+
+	GridBase* ReadWrite_ReadRaw(const char* path, int width, int height, int depth, int sample_type, long long header_bytes, double threshold)
+	{
+		openvdb::initialize();
+
+		if (width <= 0 || height <= 0 || depth <= 0 || header_bytes < 0)
+		{
+			std::cerr << "Invalid raw volume layout" << std::endl;
+			return nullptr;
+		}
+
+		RawVolumeInfo info;
+		info.width = (uint32_t)width;
+		info.height = (uint32_t)height;
+		info.depth = (uint32_t)depth;
+		info.sample_type = (RawVolumeInfo::SampleType)sample_type;
+		info.header_bytes = (uint64_t)header_bytes;
+
+		return to_grid_base(load_raw_volume(path, info, threshold));
+	}
+
+	GridBase* ReadWrite_ReadMhd(const char* path, double threshold)
+	{
+		openvdb::initialize();
+
+		return to_grid_base(load_raw_volume(std::string(path), threshold));
+	}
+
+	GridBase* ReadWrite_ReadVdbBands(const char* path)
+	{
+		return to_grid_base(read_vdb_bands(path));
+	}
+
+	int ReadWrite_AppendTiff(GridBase* ptr, const char* path, double threshold, int threshold_mode, int crop, int reduction, int* offset, int blend, TiffReadStats* stats)
+	{
+		openvdb::FloatGrid::Ptr grid = ptr ? openvdb::gridPtrCast<openvdb::FloatGrid>(ptr->m_grid) : nullptr;
+		if (!grid)
+		{
+			std::cerr << "TIFF pages can only be appended to a float grid" << std::endl;
+			return -1;
+		}
+
+		TiffReadSettings settings = tiff_read_settings(threshold, threshold_mode, crop, reduction, nullptr, nullptr);
+		if (offset)
+			settings.offset = openvdb::Coord(offset[0], offset[1], offset[2]);
+
+		TiffBlendMode blend_mode = (TiffBlendMode)std::min(std::max(blend, 0), (int)BLEND_AVERAGE);
+
+		return append_scalar_tiff(*grid, path, settings, blend_mode, stats);
+	}
+
+	int ReadWrite_ConvertTiff(const char* path, const char* out_path, double threshold, int threshold_mode, int reduction, int band_pages, int float_as_half)
+	{
+		openvdb::initialize();
+
+		TiffReadSettings settings = tiff_read_settings(threshold, threshold_mode, 0, reduction, nullptr, nullptr);
+
+		try
+		{
+			return convert_tiff_to_vdb(path, out_path, settings, (unsigned int)std::max(band_pages, 1), float_as_half != 0);
+		}
+		catch (std::exception e)
+		{
+			std::cerr << e.what() << std::endl;
+			return -1;
+		}
+	}
+
 	void ReadWrite_WriteVdb(const char* path, int num_grids, GridBase** grids, int float_as_half)
 	{
 		openvdb::io::File file(path);
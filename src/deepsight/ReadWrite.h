@@ -19,38 +19,253 @@
 
 #include "Grid.h"
 #include "InfoLog.h"
+#include "InfoLogCache.h"
 #include "GridBase.h"
+#include "QuantizedGrid.h"
+#include "Slabs.h"
+#include "TiffPage.h"
+#include "MappedFile.h"
 
 #include <map>
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <limits>
+#include <cstring>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
 #include "config.h"
 
 #include "tiff.h"
 #include "tiffio.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include <Eigen/Geometry>
 
 
 namespace DeepSight
 {
+	struct TiffReadSettings
+	{
+		enum ThresholdMode
+		{
+			THRESHOLD_FIXED,
+			THRESHOLD_OTSU,
+			THRESHOLD_PERCENTILE
+		};
+
+		double threshold = 1.0e-3;
+
+		// How the threshold is chosen. THRESHOLD_FIXED uses threshold as is. The other
+		// modes replace it with the Otsu threshold or the threshold_percentile (0 - 1)
+		// of a histogram of threshold_sample_pages pages spread over the region, which
+		// are sampled in a quick first pass.
+		ThresholdMode threshold_mode = THRESHOLD_FIXED;
+		double threshold_percentile = 0.5;
+		unsigned int threshold_sample_pages = 16;
+
+		// Number of pixels dropped from every side of the frames
+		unsigned int crop = 0;
+		bool verbose = false;
+
+		// Index-space region to load, inclusive. x and y select frame columns and rows,
+		// z selects pages. Only the strips and tiles inside the region are decoded and
+		// pages outside of it are skipped. The default empty box loads the whole stack.
+		openvdb::CoordBBox bbox;
+
+		// Integer reduction factor, e.g. 2, 4 or 8. Every voxel of the grid averages a
+		// box of reduction^3 pixels while the stack is read, and the transform of the
+		// grid is scaled to match.
+		unsigned int reduction = 1;
+
+		// Distance between two pages, in pixels. Sets the z scale of the grid transform.
+		double z_spacing = 1.0;
+
+		// Index-space offset added to every voxel, in output voxels (after the reduction).
+		// Offsets with x and y multiples of 8 keep the leaf-based construction, any z works.
+		openvdb::Coord offset = openvdb::Coord(0);
+
+		// Number of ingest threads. 0 uses all available cores.
+		unsigned int num_threads = 0;
+
+		// Build 8x8x8 leaf nodes from slabs of 8 pages and attach them to the tree
+		// whole, instead of inserting every voxel through an accessor.
+		bool slab_leaves = true;
+
+		// Decode grey and RGB pages from their native samples. When off, every page
+		// goes through the RGBA interface and is quantized to 8 bits per channel.
+		bool native_decode = true;
+
+		// Decode slabs in bands of 8 rows, one strip or tile at a time, instead of
+		// whole frames. Scratch memory per thread then no longer grows with frame height.
+		bool streaming = true;
+	};
+
+	// Statistics of the values of a loaded region, collected in the same pass as the
+	// grid. The histogram range is set by the caller, everything else is filled in.
+	// Plain data, so that it can be handed through the C API as is.
+	struct TiffReadStats
+	{
+		static const int NUM_BINS = 256;
+
+		// Value range of the histogram. Values outside of it are counted in the first or last bin.
+		double hist_min = 0.0, hist_max = 1.0;
+		uint64_t histogram[NUM_BINS] = {};
+
+		// Number of values in the region, and of values at or above the threshold (active voxels)
+		uint64_t total_count = 0, active_count = 0;
+
+		// Threshold the region was loaded with, chosen automatically or not
+		double threshold = 0.0;
+
+		double min = std::numeric_limits<double>::max(), max = -std::numeric_limits<double>::max();
+		double mean = 0.0, variance = 0.0;
+
+		// Sum of squared differences from the mean, used to merge partial statistics
+		double m2 = 0.0;
+
+		void merge(const TiffReadStats& other);
+
+		// Value below which the fraction p (0 - 1) of all values falls, interpolated within its bin.
+		double percentile(double p) const;
+
+		// Value that best separates the histogram into two classes (Otsu's method).
+		double otsu_threshold() const;
+	};
+
+	// How the voxels of appended pages are combined with the active voxels of a grid
+	enum TiffBlendMode
+	{
+		// Voxels in the region of the pages are replaced, also by voxels below the threshold
+		BLEND_OVERWRITE,
+		BLEND_MAX,
+		// Mean of the existing and the new value. Voxels below the threshold are left out.
+		BLEND_AVERAGE
+	};
+
 	//template <typename T>
 	Grid<float>::Ptr load_scalar_tiff(const std::string path, double threshold = 1.0e-3, unsigned int crop = 0, bool verbose = false);
-	//std::shared_ptr<Grid<openvdb::Vec3f>> load_vector_tiff(const std::string path, double threshold = 1.0e-3, unsigned int crop = 0);
+	Grid<float>::Ptr load_scalar_tiff(const std::string path, const TiffReadSettings& settings, TiffReadStats* stats = nullptr);
 
+	// List the TIFF files of a directory, or the files matching a pattern with * and ?
+	// wildcards (e.g. "C:/scans/log_*.tif"), in natural order of their names.
+	std::vector<std::string> list_tiff_sequence(const std::string pattern);
+
+	// Load a directory or pattern of single-slice TIFF files as consecutive pages.
+	Grid<float>::Ptr load_scalar_tiff_sequence(const std::string pattern, const TiffReadSettings& settings, TiffReadStats* stats = nullptr);
+
+	// Load a multi-page TIFF, or a directory or pattern of single-slice files, into an existing
+	// grid at the offset of the settings. Pages are read in parallel into a tree of their
+	// own leaves, which are then moved into the grid or blended with the leaves it already
+	// has. The grid keeps its transform, so reduction and spacing should match it.
+	// Returns the number of pages appended, or -1.
+	int append_scalar_tiff(openvdb::FloatGrid& grid, const std::string path, const TiffReadSettings& settings, TiffBlendMode blend = BLEND_MAX, TiffReadStats* stats = nullptr);
+
+	// Convert a multi-page TIFF, or a directory or pattern of single-slice files, into
+	// one .vdb file per band of band_pages pages (out_0000.vdb, out_0001.vdb, ... for
+	// out_path out.vdb). Only one band is held in memory at a time, and all bands share
+	// index space and transform, so read_vdb_bands can merge them into one grid again.
+	// Returns the number of files written, or -1.
+	int convert_tiff_to_vdb(const std::string path, const std::string out_path, const TiffReadSettings& settings, unsigned int band_pages = 256, bool float_as_half = false, TiffReadStats* stats = nullptr);
+
+	// Load a multi-page TIFF of vectors, one component per colour channel (see
+	// TiffPage::read_vector_row). Vectors shorter than the threshold are left out,
+	// and stats describe the vector lengths.
 	Grid<openvdb::Vec3f>::Ptr load_vector_tiff(const std::string path, double threshold = 1.0e-3, unsigned int crop = 0);
-	DEEPSIGHT_EXPORT RawLam::InfoLog::Ptr load_infolog(const std::string path, bool verbose = false);
+	Grid<openvdb::Vec3f>::Ptr load_vector_tiff(const std::string path, const TiffReadSettings& settings, TiffReadStats* stats = nullptr);
+
+	// Load a directory or pattern of single-slice vector TIFF files as consecutive pages.
+	Grid<openvdb::Vec3f>::Ptr load_vector_tiff_sequence(const std::string pattern, const TiffReadSettings& settings, TiffReadStats* stats = nullptr);
+
+	// Layout of an uncompressed little-endian volume, with x varying fastest, then y, then z.
+	struct RawVolumeInfo
+	{
+		enum SampleType
+		{
+			RAW_UINT8,
+			RAW_UINT16,
+			RAW_FLOAT32
+		};
+
+		uint32_t width = 0, height = 0, depth = 0;
+		SampleType sample_type = RAW_UINT8;
+
+		// Bytes in front of the first sample, e.g. of a header
+		uint64_t header_bytes = 0;
+
+		// Size of a voxel along x, y and z. The grid is scaled by the ratios to the x spacing.
+		double spacing[3] = { 1.0, 1.0, 1.0 };
+	};
+
+	// Read the layout of a volume from a MetaImage header (.mhd, or .mha with the data
+	// appended), and the path of the file holding the samples.
+	bool read_raw_header(const std::string path, RawVolumeInfo& info, std::string& data_path);
+
+	// Load an uncompressed volume through a memory mapping, building the leaves straight
+	// from the mapped samples. Integer samples are scaled by the range of their type.
+	Grid<float>::Ptr load_raw_volume(const std::string path, const RawVolumeInfo& info, double threshold = 1.0e-3, unsigned int num_threads = 0, bool verbose = false);
+
+	// Load the volume described by a MetaImage header.
+	Grid<float>::Ptr load_raw_volume(const std::string header_path, double threshold = 1.0e-3, unsigned int num_threads = 0, bool verbose = false);
+
+	// Load an InfoLog TIFF. With use_cache, the parsed InfoLog is kept in a binary cache next
+	// to the TIFF (see InfoLogCache.h), and later loads map the cache instead of parsing the
+	// TIFF again, as long as the TIFF has not changed.
+	DEEPSIGHT_EXPORT RawLam::InfoLog::Ptr load_infolog(const std::string path, bool verbose = false, bool use_cache = true);
 
 	std::vector<GridBase*> read_vdb(const std::string path);
 
+	// Read the bands written by convert_tiff_to_vdb for out_path (out_0000.vdb, out_0001.vdb,
+	// ... for out.vdb) and merge them into one float grid.
+	Grid<float>::Ptr read_vdb_bands(const std::string out_path);
+
 #ifdef __cplusplus
 	extern "C" {
 #endif
 	DEEPSIGHT_EXPORT void ReadWrite_ReadVdb(const char* path, int* num_grids, GridBase** grid_ptrs);
 	DEEPSIGHT_EXPORT void ReadWrite_WriteVdb(const char* path, int num_grids, GridBase** grids, int float_as_half);
 
+	// Load a scalar multi-page TIFF, or a directory or pattern of single-slice TIFF files (see
+	// list_tiff_sequence). threshold_mode is a TiffReadSettings::ThresholdMode; with
+	// THRESHOLD_PERCENTILE, threshold is the percentile (0 - 1), with THRESHOLD_OTSU it is ignored.
+	// bbox_min and bbox_max (3 ints each) select an index-space region and may be null. stats may
+	// be null, otherwise it receives the statistics of the region.
+	DEEPSIGHT_EXPORT GridBase* ReadWrite_ReadTiff(const char* path, double threshold, int threshold_mode, int crop, int reduction, int* bbox_min, int* bbox_max, TiffReadStats* stats);
+
+	// Load a vector multi-page TIFF, or a directory or pattern of slices, into a Vec3f grid, with
+	// the arguments of ReadWrite_ReadTiff. The threshold applies to the vector lengths.
+	DEEPSIGHT_EXPORT GridBase* ReadWrite_ReadTiffVector(const char* path, double threshold, int threshold_mode, int crop, int reduction, int* bbox_min, int* bbox_max, TiffReadStats* stats);
+
+	// Load a directory or pattern of single-slice TIFF files (or a multi-page TIFF) with the
+	// arguments of ReadWrite_ReadTiff, z_spacing pixels apart, decoding the slices on num_threads
+	// threads (0 uses all cores).
+	DEEPSIGHT_EXPORT GridBase* ReadWrite_ReadTiffSequence(const char* path, double threshold, int threshold_mode, int crop, int reduction, double z_spacing, int num_threads, int* bbox_min, int* bbox_max, TiffReadStats* stats);
+
+	// Convert a TIFF stack into one .vdb file per band of band_pages pages. threshold and
+	// threshold_mode are used as by ReadWrite_ReadTiff. Returns the number of files written, or -1.
+	DEEPSIGHT_EXPORT int ReadWrite_ConvertTiff(const char* path, const char* out_path, double threshold, int threshold_mode, int reduction, int band_pages, int float_as_half);
+
+	// Load a TIFF stack into the float grid ptr at the index offset (3 ints, may be null). blend is
+	// a TiffBlendMode, the other arguments are used as by ReadWrite_ReadTiff. Returns the number
+	// of pages appended, or -1.
+	DEEPSIGHT_EXPORT int ReadWrite_AppendTiff(GridBase* ptr, const char* path, double threshold, int threshold_mode, int crop, int reduction, int* offset, int blend, TiffReadStats* stats);
+
+	// Load an uncompressed volume. sample_type is a RawVolumeInfo::SampleType.
+	DEEPSIGHT_EXPORT GridBase* ReadWrite_ReadRaw(const char* path, int width, int height, int depth, int sample_type, long long header_bytes, double threshold);
+
+	// Load the uncompressed volume described by a MetaImage header (.mhd or .mha).
+	DEEPSIGHT_EXPORT GridBase* ReadWrite_ReadMhd(const char* path, double threshold);
+
+	// Merge the band files written by ReadWrite_ConvertTiff for out_path into one float grid.
+	DEEPSIGHT_EXPORT GridBase* ReadWrite_ReadVdbBands(const char* path);
+
 #ifdef __cplusplus
 	}
 #endif
@@ -0,0 +1,29 @@
+#ifndef SLABS_H
+#define SLABS_H
+
+#include <tbb/blocked_range.h>
+
+namespace DeepSight
+{
+	/*
+	Several tools build a grid in parallel from slabs of index z slices, one leaf deep
+	(8 slices), or more when the slices are reduced. Every task then owns the leaves of
+	its slabs. Slabs are leaf-aligned in z, so joining the trees of two tasks with
+	Tree::merge only has to splice nodes.
+	*/
+
+	// Integer division rounded towards negative infinity
+	inline int floor_div(int a, int b)
+	{
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+
+	// Slabs of depth slices that cover the slices [k_begin, k_end). Slab s holds the slices
+	// [s * depth, (s + 1) * depth).
+	inline tbb::blocked_range<int> slab_range(int k_begin, int k_end, int depth = 8)
+	{
+		return tbb::blocked_range<int>(floor_div(k_begin, depth), floor_div(k_end - 1, depth) + 1);
+	}
+}
+
+#endif
@@ -0,0 +1,466 @@
+#include "TiffPage.h"
+
+#include <iostream>
+#include <algorithm>
+
+namespace DeepSight
+{
+	// Sum the first nchannels samples of every pixel and scale them to density.
+	template<typename SampleT>
+	static void samples_to_density(const uint8_t* src, uint32_t n, uint16_t stride, uint16_t nchannels, double denom, float* dst, bool accumulate)
+	{
+		const SampleT* s = reinterpret_cast<const SampleT*>(src);
+
+		for (uint32_t i = 0; i < n; ++i, s += stride)
+		{
+			double sum = 0.0;
+			for (uint16_t c = 0; c < nchannels; ++c)
+				sum += (double)s[c];
+
+			if (accumulate)
+				dst[i] += (float)(sum / denom);
+			else
+				dst[i] = (float)(sum / denom);
+		}
+	}
+
+	// Scale the first nchannels samples of every pixel to vector components. Pixels are
+	// written 3 floats apart, so separate planes can fill one component each.
+	template<typename SampleT>
+	static void samples_to_vectors(const uint8_t* src, uint32_t n, uint16_t stride, uint16_t nchannels, double denom, double bias, float* dst)
+	{
+		const SampleT* s = reinterpret_cast<const SampleT*>(src);
+
+		for (uint32_t i = 0; i < n; ++i, s += stride, dst += 3)
+			for (uint16_t c = 0; c < nchannels; ++c)
+				dst[c] = (float)((double)s[c] / denom - bias);
+	}
+
+	// Convert packed RGBA pixels to density, the way the loaders always did.
+	static void rgba_to_density(const uint32_t* src, uint32_t n, float* dst)
+	{
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			const uint32_t& TiffPixel = src[i]; // read the current pixel of the TIF
+			dst[i] = float(((float)(TIFFGetR(TiffPixel) + TIFFGetG(TiffPixel) + TIFFGetB(TiffPixel))) / (255. * 3));
+		}
+	}
+
+	// Convert packed RGBA pixels to vectors centred on zero.
+	static void rgba_to_vectors(const uint32_t* src, uint32_t n, float* dst)
+	{
+		for (uint32_t i = 0; i < n; ++i, dst += 3)
+		{
+			dst[0] = (float)(TIFFGetR(src[i]) / 255. - 0.5);
+			dst[1] = (float)(TIFFGetG(src[i]) / 255. - 0.5);
+			dst[2] = (float)(TIFFGetB(src[i]) / 255. - 0.5);
+		}
+	}
+
+	TiffPage::TiffPage()
+		: width(0), height(0), samplesperpixel(1), bitspersample(8), sampleformat(SAMPLEFORMAT_UINT)
+		, planarconfig(PLANARCONFIG_CONTIG), photometric(PHOTOMETRIC_MINISBLACK), orientation(ORIENTATION_TOPLEFT)
+		, tiled(false), native(false), x0(0), y0(0), x1(0), y1(0), m_tif(nullptr), m_mode(RGBA_IMAGE), m_convert(nullptr), m_convert_vector(nullptr)
+		, m_denom(1.0), m_sample_denom(1.0), m_sample_bias(0.0)
+		, m_channels(1), m_planes(1), m_stride(1), m_invert(false)
+		, m_block_width(0), m_block_height(0), m_tile_begin(0), m_tile_end(0)
+		, m_block_row_bytes(0), m_pixel_bytes(0), m_tile_bytes(0)
+	{
+	}
+
+	bool TiffPage::open(TIFF* tif, bool native_decode)
+	{
+		m_tif = tif;
+
+		TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
+		TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
+		TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
+		TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
+		TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLEFORMAT, &sampleformat);
+		TIFFGetFieldDefaulted(tif, TIFFTAG_PLANARCONFIG, &planarconfig);
+		TIFFGetFieldDefaulted(tif, TIFFTAG_ORIENTATION, &orientation);
+		if (!TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric))
+			photometric = PHOTOMETRIC_MINISBLACK;
+
+		tiled = TIFFIsTiled(tif) != 0;
+
+		// Pick the sample conversion
+		m_convert = nullptr;
+		m_convert_vector = nullptr;
+		switch (sampleformat)
+		{
+		case(SAMPLEFORMAT_UINT):
+			if (bitspersample == 8) { m_convert = samples_to_density<uint8_t>; m_convert_vector = samples_to_vectors<uint8_t>; m_denom = 255.0; }
+			else if (bitspersample == 16) { m_convert = samples_to_density<uint16_t>; m_convert_vector = samples_to_vectors<uint16_t>; m_denom = 65535.0; }
+			else if (bitspersample == 32) { m_convert = samples_to_density<uint32_t>; m_convert_vector = samples_to_vectors<uint32_t>; m_denom = 4294967295.0; }
+			break;
+		case(SAMPLEFORMAT_INT):
+			if (bitspersample == 8) { m_convert = samples_to_density<int8_t>; m_convert_vector = samples_to_vectors<int8_t>; m_denom = 127.0; }
+			else if (bitspersample == 16) { m_convert = samples_to_density<int16_t>; m_convert_vector = samples_to_vectors<int16_t>; m_denom = 32767.0; }
+			else if (bitspersample == 32) { m_convert = samples_to_density<int32_t>; m_convert_vector = samples_to_vectors<int32_t>; m_denom = 2147483647.0; }
+			break;
+		case(SAMPLEFORMAT_IEEEFP):
+			if (bitspersample == 32) { m_convert = samples_to_density<float>; m_convert_vector = samples_to_vectors<float>; m_denom = 1.0; }
+			else if (bitspersample == 64) { m_convert = samples_to_density<double>; m_convert_vector = samples_to_vectors<double>; m_denom = 1.0; }
+			break;
+		default:
+			break;
+		}
+
+		bool grey = photometric == PHOTOMETRIC_MINISBLACK || photometric == PHOTOMETRIC_MINISWHITE;
+		bool rgb = photometric == PHOTOMETRIC_RGB && samplesperpixel >= 3;
+		bool upright = orientation == ORIENTATION_TOPLEFT || orientation == ORIENTATION_BOTLEFT;
+
+		native = native_decode && m_convert != nullptr && (grey || rgb) && upright;
+
+		if (native)
+			m_mode = NATIVE;
+		else if (orientation == ORIENTATION_TOPLEFT)
+			m_mode = RGBA_BLOCKS;
+		else
+			m_mode = RGBA_IMAGE;
+
+		m_channels = native && rgb ? 3 : 1;
+		m_sample_denom = m_denom;
+		m_sample_bias = sampleformat == SAMPLEFORMAT_UINT ? 0.5 : 0.0;
+		m_denom *= m_channels;
+		m_invert = native && photometric == PHOTOMETRIC_MINISWHITE && sampleformat != SAMPLEFORMAT_IEEEFP;
+
+		if (native && planarconfig == PLANARCONFIG_SEPARATE)
+		{
+			m_planes = m_channels;
+			m_stride = 1;
+		}
+		else
+		{
+			m_planes = 1;
+			m_stride = native ? samplesperpixel : 1;
+		}
+
+		// RGBA decoding always produces a single plane of packed pixels
+		size_t sample_bytes = native ? bitspersample / 8 : sizeof(uint32_t);
+
+		if (m_mode == RGBA_IMAGE)
+		{
+			m_block_width = width;
+			m_block_height = height;
+			m_tile_bytes = (size_t)width * height * sample_bytes;
+			m_block_row_bytes = (size_t)width * sample_bytes;
+		}
+		else if (tiled)
+		{
+			TIFFGetField(tif, TIFFTAG_TILEWIDTH, &m_block_width);
+			TIFFGetField(tif, TIFFTAG_TILELENGTH, &m_block_height);
+			m_tile_bytes = native ? (size_t)TIFFTileSize(tif) : (size_t)m_block_width * m_block_height * sample_bytes;
+			m_block_row_bytes = m_block_width * m_stride * sample_bytes;
+		}
+		else
+		{
+			uint32_t rowsperstrip;
+			TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsperstrip);
+
+			m_block_width = width;
+			m_block_height = std::min(rowsperstrip, height);
+			m_tile_bytes = native ? (size_t)TIFFStripSize(tif) : (size_t)width * m_block_height * sample_bytes;
+			m_block_row_bytes = (size_t)width * m_stride * sample_bytes;
+		}
+
+		if (m_block_width == 0 || m_block_height == 0)
+		{
+			std::cerr << "Invalid strip or tile layout of TIFF image" << std::endl;
+			return false;
+		}
+
+		m_pixel_bytes = m_stride * sample_bytes;
+		m_blocks.resize(m_planes);
+
+		set_window(0, 0, width, height);
+
+		return true;
+	}
+
+	void TiffPage::set_window(uint32_t wx0, uint32_t wy0, uint32_t wx1, uint32_t wy1)
+	{
+		x0 = std::min(wx0, width);
+		y0 = std::min(wy0, height);
+		x1 = std::min(std::max(wx1, x0), width);
+		y1 = std::min(std::max(wy1, y0), height);
+
+		if (x1 == x0)
+		{
+			m_tile_begin = m_tile_end = 0;
+		}
+		else
+		{
+			m_tile_begin = x0 / m_block_width;
+			m_tile_end = (x1 + m_block_width - 1) / m_block_width;
+		}
+
+		m_cached_block.assign(m_planes, -1);
+	}
+
+	size_t TiffPage::scratch_size() const
+	{
+		size_t size = 0;
+		for (auto& block : m_blocks)
+			size += block.capacity();
+		return size;
+	}
+
+	bool TiffPage::load_block(uint32_t block, uint16_t plane)
+	{
+		if (m_cached_block[plane] == (int64_t)block)
+			return true;
+
+		std::vector<uint8_t>& buffer = m_blocks[plane];
+		buffer.resize(m_tile_bytes * (m_tile_end - m_tile_begin));
+
+		uint32_t row = block * m_block_height;
+
+		switch (m_mode)
+		{
+		case(NATIVE):
+			if (tiled)
+			{
+				for (uint32_t t = m_tile_begin; t < m_tile_end; ++t)
+				{
+					ttile_t tile = TIFFComputeTile(m_tif, t * m_block_width, row, 0, plane);
+					if (TIFFReadEncodedTile(m_tif, tile, &buffer[(t - m_tile_begin) * m_tile_bytes], (tmsize_t)m_tile_bytes) < 0)
+					{
+						std::cerr << "Could not read tile " << tile << " of TIFF image" << std::endl;
+						return false;
+					}
+				}
+			}
+			else
+			{
+				tstrip_t strip = TIFFComputeStrip(m_tif, row, plane);
+				if (TIFFReadEncodedStrip(m_tif, strip, buffer.data(), (tmsize_t)m_tile_bytes) < 0)
+				{
+					std::cerr << "Could not read strip " << strip << " of TIFF image" << std::endl;
+					return false;
+				}
+			}
+			break;
+		case(RGBA_BLOCKS):
+			if (tiled)
+			{
+				for (uint32_t t = m_tile_begin; t < m_tile_end; ++t)
+				{
+					if (!TIFFReadRGBATile(m_tif, t * m_block_width, row, reinterpret_cast<uint32_t*>(&buffer[(t - m_tile_begin) * m_tile_bytes])))
+					{
+						std::cerr << "Could not read raster of TIFF image" << std::endl;
+						return false;
+					}
+				}
+			}
+			else if (!TIFFReadRGBAStrip(m_tif, row, reinterpret_cast<uint32_t*>(buffer.data())))
+			{
+				std::cerr << "Could not read raster of TIFF image" << std::endl;
+				return false;
+			}
+			break;
+		case(RGBA_IMAGE):
+			if (!TIFFReadRGBAImage(m_tif, width, height, reinterpret_cast<uint32_t*>(buffer.data()), 0))
+			{
+				std::cerr << "Could not read raster of TIFF image" << std::endl;
+				return false;
+			}
+			break;
+		}
+
+		m_cached_block[plane] = block;
+		return true;
+	}
+
+	bool TiffPage::read_native_row(uint32_t row, float* dst)
+	{
+		uint32_t block = row / m_block_height;
+		size_t row_offset = (row - block * m_block_height) * m_block_row_bytes;
+
+		for (uint16_t plane = 0; plane < m_planes; ++plane)
+		{
+			if (!load_block(block, plane))
+				return false;
+
+			const uint8_t* buffer = m_blocks[plane].data();
+
+			// Separate planes hold one channel each, their raw samples are summed up first
+			uint16_t nchannels = m_planes > 1 ? 1 : m_channels;
+			double denom = m_planes > 1 ? 1.0 : m_denom;
+
+			for (uint32_t t = m_tile_begin; t < m_tile_end; ++t)
+			{
+				uint32_t tx = t * m_block_width;
+				uint32_t xa = std::max(tx, x0);
+				uint32_t xb = std::min(tx + m_block_width, x1);
+
+				const uint8_t* src = buffer + (t - m_tile_begin) * m_tile_bytes + row_offset + (xa - tx) * m_pixel_bytes;
+				m_convert(src, xb - xa, m_stride, nchannels, denom, dst + (xa - x0), plane > 0);
+			}
+		}
+
+		uint32_t n = window_width();
+
+		if (m_planes > 1)
+			for (uint32_t x = 0; x < n; ++x)
+				dst[x] = (float)((double)dst[x] / m_denom);
+
+		if (m_invert)
+			for (uint32_t x = 0; x < n; ++x)
+				dst[x] = 1.0f - dst[x];
+
+		return true;
+	}
+
+	bool TiffPage::read_rgba_row(uint32_t row, float* dst)
+	{
+		uint32_t block = row / m_block_height;
+		uint32_t block_row = row - block * m_block_height;
+
+		if (!load_block(block, 0))
+			return false;
+
+		const uint32_t* raster = reinterpret_cast<const uint32_t*>(m_blocks[0].data());
+
+		// RGBA strips and tiles come out with their origin in the lower-left corner. A
+		// partial strip only holds its valid rows, a partial tile is padded at the top.
+		uint32_t rows_in_block = tiled ? m_block_height : std::min(m_block_height, height - block * m_block_height);
+		size_t raster_row = rows_in_block - 1 - block_row;
+
+		for (uint32_t t = m_tile_begin; t < m_tile_end; ++t)
+		{
+			uint32_t tx = t * m_block_width;
+			uint32_t xa = std::max(tx, x0);
+			uint32_t xb = std::min(tx + m_block_width, x1);
+
+			const uint32_t* src = raster + (t - m_tile_begin) * (m_tile_bytes / sizeof(uint32_t)) + raster_row * m_block_width + (xa - tx);
+			rgba_to_density(src, xb - xa, dst + (xa - x0));
+		}
+
+		return true;
+	}
+
+	bool TiffPage::read_native_vector_row(uint32_t row, float* dst)
+	{
+		uint32_t block = row / m_block_height;
+		size_t row_offset = (row - block * m_block_height) * m_block_row_bytes;
+
+		for (uint16_t plane = 0; plane < m_planes; ++plane)
+		{
+			if (!load_block(block, plane))
+				return false;
+
+			const uint8_t* buffer = m_blocks[plane].data();
+
+			// Separate planes hold one component each
+			uint16_t nchannels = m_planes > 1 ? 1 : m_channels;
+			float* components = m_planes > 1 ? dst + plane : dst;
+
+			for (uint32_t t = m_tile_begin; t < m_tile_end; ++t)
+			{
+				uint32_t tx = t * m_block_width;
+				uint32_t xa = std::max(tx, x0);
+				uint32_t xb = std::min(tx + m_block_width, x1);
+
+				const uint8_t* src = buffer + (t - m_tile_begin) * m_tile_bytes + row_offset + (xa - tx) * m_pixel_bytes;
+				m_convert_vector(src, xb - xa, m_stride, nchannels, m_sample_denom, m_sample_bias, components + 3 * (size_t)(xa - x0));
+			}
+		}
+
+		uint32_t n = window_width();
+
+		if (m_channels == 1)
+			for (uint32_t x = 0; x < n; ++x)
+				dst[3 * x + 1] = dst[3 * x + 2] = dst[3 * x];
+
+		if (m_invert)
+			for (size_t i = 0; i < 3 * (size_t)n; ++i)
+				dst[i] = -dst[i];
+
+		return true;
+	}
+
+	bool TiffPage::read_rgba_vector_row(uint32_t row, float* dst)
+	{
+		uint32_t block = row / m_block_height;
+		uint32_t block_row = row - block * m_block_height;
+
+		if (!load_block(block, 0))
+			return false;
+
+		const uint32_t* raster = reinterpret_cast<const uint32_t*>(m_blocks[0].data());
+
+		uint32_t rows_in_block = tiled ? m_block_height : std::min(m_block_height, height - block * m_block_height);
+		size_t raster_row = rows_in_block - 1 - block_row;
+
+		for (uint32_t t = m_tile_begin; t < m_tile_end; ++t)
+		{
+			uint32_t tx = t * m_block_width;
+			uint32_t xa = std::max(tx, x0);
+			uint32_t xb = std::min(tx + m_block_width, x1);
+
+			const uint32_t* src = raster + (t - m_tile_begin) * (m_tile_bytes / sizeof(uint32_t)) + raster_row * m_block_width + (xa - tx);
+			rgba_to_vectors(src, xb - xa, dst + 3 * (size_t)(xa - x0));
+		}
+
+		return true;
+	}
+
+	bool TiffPage::read_frame_row(uint32_t y, float* dst)
+	{
+		if (x1 == x0)
+			return true;
+
+		switch (m_mode)
+		{
+		case(NATIVE):
+			return read_native_row(orientation == ORIENTATION_BOTLEFT ? y : height - 1 - y, dst);
+		case(RGBA_BLOCKS):
+			return read_rgba_row(height - 1 - y, dst);
+		default:
+			// The whole image is a single block, already in frame order
+			if (!load_block(0, 0))
+				return false;
+
+			rgba_to_density(reinterpret_cast<const uint32_t*>(m_blocks[0].data()) + (size_t)y * width + x0, window_width(), dst);
+			return true;
+		}
+	}
+
+	bool TiffPage::read_vector_row(uint32_t y, float* dst)
+	{
+		if (x1 == x0)
+			return true;
+
+		switch (m_mode)
+		{
+		case(NATIVE):
+			return read_native_vector_row(orientation == ORIENTATION_BOTLEFT ? y : height - 1 - y, dst);
+		case(RGBA_BLOCKS):
+			return read_rgba_vector_row(height - 1 - y, dst);
+		default:
+			if (!load_block(0, 0))
+				return false;
+
+			rgba_to_vectors(reinterpret_cast<const uint32_t*>(m_blocks[0].data()) + (size_t)y * width + x0, window_width(), dst);
+			return true;
+		}
+	}
+
+	bool TiffPage::read_frame(std::vector<float>& frame, float& max_val)
+	{
+		frame.resize((size_t)window_width() * window_height());
+
+		for (uint32_t y = y0; y < y1; ++y)
+		{
+			if (!read_frame_row(y, &frame[(size_t)(y - y0) * window_width()]))
+				return false;
+		}
+
+		for (float val : frame)
+			max_val = std::max(max_val, val);
+
+		return true;
+	}
+}
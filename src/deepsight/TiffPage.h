@@ -0,0 +1,110 @@
+#ifndef TIFF_PAGE_H
+#define TIFF_PAGE_H
+
+#include "tiff.h"
+#include "tiffio.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace DeepSight
+{
+	/*
+	Decodes a single TIFF directory into float density values.
+
+	Grey and RGB pages with 8/16/32-bit integer or 32/64-bit float samples are
+	read natively through their strips or tiles, and integer samples are scaled
+	by the range of their type so that 16-bit data keeps its full precision.
+	RGB pages are averaged over their three colour channels, or read as vectors
+	with one component per channel through read_vector_row(). Everything else
+	(palettes, YCbCr, odd bit depths) goes through the RGBA interface of libtiff,
+	like the loaders always did.
+
+	Pages are decoded one strip or tile row at a time into a buffer that is
+	reused between calls, so the scratch memory of a page does not depend on
+	its height. Only pages that need the RGBA interface and are not stored
+	top-left fall back to decoding the whole image at once.
+
+	Frames are stored bottom-up (frame row 0 is the last image row), which is
+	the orientation the RGBA interface has always produced.
+	*/
+	class TiffPage
+	{
+	public:
+		TiffPage();
+
+		// Read the layout of the current directory of the TIFF. With native_decode
+		// off, every page is decoded through the RGBA interface.
+		bool open(TIFF* tif, bool native_decode = true);
+
+		// Restrict decoding to the frame rows [y0, y1) and columns [x0, x1). Tiles
+		// outside of the columns are never read. open() resets the window to the page.
+		void set_window(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+
+		// Decode the rows of the window into a frame of window_width() values per row.
+		bool read_frame(std::vector<float>& frame, float& max_val);
+
+		// Decode the window columns of frame row y into window_width() values.
+		// Rows are cheapest to read in order.
+		bool read_frame_row(uint32_t y, float* dst);
+
+		// Decode the window columns of frame row y into window_width() vectors of three
+		// floats, one per colour channel. Grey pages fill all three components. Unsigned
+		// integer samples are centred on zero (s / max - 0.5), signed integer samples are
+		// scaled by their range and float samples are kept as they are.
+		bool read_vector_row(uint32_t y, float* dst);
+
+		uint32_t window_width() const { return x1 - x0; }
+		uint32_t window_height() const { return y1 - y0; }
+
+		// Bytes held by the decode buffers of this page.
+		size_t scratch_size() const;
+
+		uint32_t width, height;
+		uint16_t samplesperpixel, bitspersample, sampleformat;
+		uint16_t planarconfig, photometric, orientation;
+		bool tiled;
+
+		// False if the page has to be decoded through the RGBA interface
+		bool native;
+
+		// Window in frame coordinates
+		uint32_t x0, y0, x1, y1;
+
+	private:
+		enum Mode
+		{
+			NATIVE,
+			RGBA_BLOCKS,
+			RGBA_IMAGE
+		};
+
+		using ConvertFn = void(*)(const uint8_t* src, uint32_t n, uint16_t stride, uint16_t nchannels, double denom, float* dst, bool accumulate);
+		using ConvertVectorFn = void(*)(const uint8_t* src, uint32_t n, uint16_t stride, uint16_t nchannels, double denom, double bias, float* dst);
+
+		bool load_block(uint32_t block, uint16_t plane);
+		bool read_native_row(uint32_t row, float* dst);
+		bool read_rgba_row(uint32_t row, float* dst);
+		bool read_native_vector_row(uint32_t row, float* dst);
+		bool read_rgba_vector_row(uint32_t row, float* dst);
+
+		TIFF* m_tif;
+		Mode m_mode;
+
+		ConvertFn m_convert;
+		ConvertVectorFn m_convert_vector;
+		double m_denom, m_sample_denom, m_sample_bias;
+		uint16_t m_channels, m_planes, m_stride;
+		bool m_invert;
+
+		// A block is a strip, or a full row of tiles.
+		uint32_t m_block_width, m_block_height;
+		uint32_t m_tile_begin, m_tile_end;
+		size_t m_block_row_bytes, m_pixel_bytes, m_tile_bytes;
+
+		std::vector<std::vector<uint8_t>> m_blocks;
+		std::vector<int64_t> m_cached_block;
+	};
+}
+
+#endif
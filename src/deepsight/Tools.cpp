@@ -79,6 +79,285 @@ namespace DeepSight
 		openvdb::tools::dilateActiveValues(source->tree(), iterations, openvdb::tools::NearestNeighbors::NN_FACE_EDGE_VERTEX);
 	}
 
+	void filter_quantized(GridBase* grid, int width, int iterations, int type)
+	{
+		GridBase* decoded = dequantize_grid(grid);
+		if (!decoded)
+			return;
+
+		filter<openvdb::FloatGrid>(decoded, width, iterations, type);
+		requantize_grid(grid, *openvdb::gridPtrCast<openvdb::FloatGrid>(decoded->m_grid));
+
+		delete decoded;
+	}
+
+	GridBase* resample_quantized(GridBase* grid, float scale)
+	{
+		GridBase* decoded = dequantize_grid(grid);
+		if (!decoded)
+			return nullptr;
+
+		GridBase* resampled = resample<openvdb::FloatGrid>(decoded, scale);
+		delete decoded;
+
+		// Takes the type and quantization of the source grid
+		GridBase* new_grid = new GridBase();
+		new_grid->m_grid = grid->m_grid;
+		requantize_grid(new_grid, *openvdb::gridPtrCast<openvdb::FloatGrid>(resampled->m_grid));
+
+		delete resampled;
+
+		return new_grid;
+	}
+
+	// Pith polyline with a frame at every point. Stations are the output z of the points: their
+	// world z, or z_origin plus the length along the pith when the slices are rotated.
+	struct PithFrames
+	{
+		std::vector<openvdb::Vec3d> points, tangents, normals;
+		std::vector<double> stations;
+
+		PithFrames(const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing, bool rotate)
+			: points(pith.size()), tangents(pith.size(), openvdb::Vec3d(0.0, 0.0, 1.0)),
+			normals(pith.size(), openvdb::Vec3d(1.0, 0.0, 0.0)), stations(pith.size())
+		{
+			for (size_t i = 0; i < pith.size(); ++i)
+			{
+				points[i] = openvdb::Vec3d(pith[i].x(), pith[i].y(), z_origin + i * z_spacing);
+				stations[i] = i == 0 || !rotate ? points[i].z() : stations[i - 1] + (points[i] - points[i - 1]).length();
+			}
+
+			if (!rotate || points.size() < 2)
+				return;
+
+			for (size_t i = 0; i < points.size(); ++i)
+			{
+				openvdb::Vec3d t = points[std::min(i + 1, points.size() - 1)] - points[i > 0 ? i - 1 : 0];
+				if (t.length() > 1.0e-9)
+					tangents[i] = t.unit();
+			}
+
+			// Parallel transport of the x axis, which keeps the slices from twisting
+			for (size_t i = 0; i < points.size(); ++i)
+			{
+				openvdb::Vec3d u = i > 0 ? normals[i - 1] : openvdb::Vec3d(1.0, 0.0, 0.0);
+				u -= tangents[i] * u.dot(tangents[i]);
+				if (u.length() < 1.0e-9)
+				{
+					u = openvdb::Vec3d(0.0, 1.0, 0.0);
+					u -= tangents[i] * u.dot(tangents[i]);
+				}
+				normals[i] = u.unit();
+			}
+		}
+
+		// Centre and in-slice axes of the slice at station s. False outside of the pith.
+		bool frame(double s, openvdb::Vec3d& centre, openvdb::Vec3d& u, openvdb::Vec3d& v) const
+		{
+			if (points.empty() || s < stations.front() || s > stations.back())
+				return false;
+
+			size_t i0 = 0, i1 = 0;
+			if (points.size() > 1)
+			{
+				i1 = std::upper_bound(stations.begin(), stations.end(), s) - stations.begin();
+				i1 = std::max<size_t>(1, std::min(i1, points.size() - 1));
+				i0 = i1 - 1;
+			}
+
+			double length = stations[i1] - stations[i0];
+			double f = length > 0.0 ? (s - stations[i0]) / length : 0.0;
+
+			centre = points[i0] + (points[i1] - points[i0]) * f;
+
+			openvdb::Vec3d t = tangents[i0] + (tangents[i1] - tangents[i0]) * f;
+			t.normalize();
+
+			u = normals[i0] + (normals[i1] - normals[i0]) * f;
+			u -= t * u.dot(t);
+			u.normalize();
+			v = t.cross(u);
+
+			return true;
+		}
+	};
+
+	// Samples slabs of 8 index z slices, so that every slab owns its leaves
+	template<typename GridT>
+	struct PithStraightener
+	{
+		using TreeT = typename GridT::TreeType;
+
+		const GridT& source;
+		const PithFrames& frames;
+		openvdb::CoordBBox bbox;
+		int k_begin, k_end;
+
+		typename TreeT::Ptr tree;
+
+		PithStraightener(const GridT& source, const PithFrames& frames, const openvdb::CoordBBox& bbox, int k_begin, int k_end)
+			: source(source), frames(frames), bbox(bbox), k_begin(k_begin), k_end(k_end),
+			tree(new TreeT(source.background()))
+		{
+		}
+
+		PithStraightener(PithStraightener& other, tbb::split)
+			: PithStraightener(other.source, other.frames, other.bbox, other.k_begin, other.k_end)
+		{
+		}
+
+		void operator()(const tbb::blocked_range<int>& slabs)
+		{
+			const openvdb::math::Transform& xform = source.transform();
+
+			typename GridT::ConstAccessor source_accessor = source.getConstAccessor();
+			openvdb::tools::GridSampler<typename GridT::ConstAccessor, openvdb::tools::BoxSampler> sampler(source_accessor, xform);
+			openvdb::tree::ValueAccessor<TreeT> accessor(*tree);
+
+			for (int slab = slabs.begin(); slab < slabs.end(); ++slab)
+			{
+				int k0 = std::max(slab * 8, k_begin), k1 = std::min(slab * 8 + 8, k_end);
+
+				for (int k = k0; k < k1; ++k)
+				{
+					double z = xform.indexToWorld(openvdb::Vec3d(0.0, 0.0, k)).z();
+
+					openvdb::Vec3d centre, u, v;
+					if (!frames.frame(z, centre, u, v))
+						continue;
+
+					// In-slice extent of the active box of the source
+					double xmin = std::numeric_limits<double>::max(), xmax = -xmin, ymin = xmin, ymax = -xmin;
+					for (int c = 0; c < 8; ++c)
+					{
+						openvdb::Vec3d corner(
+							(c & 1 ? bbox.max().x() + 0.5 : bbox.min().x() - 0.5),
+							(c & 2 ? bbox.max().y() + 0.5 : bbox.min().y() - 0.5),
+							(c & 4 ? bbox.max().z() + 0.5 : bbox.min().z() - 0.5));
+						openvdb::Vec3d d = xform.indexToWorld(corner) - centre;
+
+						xmin = std::min(xmin, d.dot(u));
+						xmax = std::max(xmax, d.dot(u));
+						ymin = std::min(ymin, d.dot(v));
+						ymax = std::max(ymax, d.dot(v));
+					}
+
+					openvdb::Vec3d i0 = xform.worldToIndex(openvdb::Vec3d(xmin, ymin, z));
+					openvdb::Vec3d i1 = xform.worldToIndex(openvdb::Vec3d(xmax, ymax, z));
+
+					for (int y = (int)std::ceil(std::min(i0.y(), i1.y())); y <= (int)std::floor(std::max(i0.y(), i1.y())); ++y)
+					{
+						for (int x = (int)std::ceil(std::min(i0.x(), i1.x())); x <= (int)std::floor(std::max(i0.x(), i1.x())); ++x)
+						{
+							openvdb::Vec3d w = xform.indexToWorld(openvdb::Coord(x, y, k));
+							openvdb::Vec3d p = xform.worldToIndex(centre + u * w.x() + v * w.y());
+
+							openvdb::Coord nearest = openvdb::Coord::round(p);
+							if (!bbox.isInside(nearest) || !source_accessor.isValueOn(nearest))
+								continue;
+
+							accessor.setValue(openvdb::Coord(x, y, k), sampler.isSample(p));
+						}
+					}
+				}
+			}
+		}
+
+		void join(PithStraightener& other)
+		{
+			tree->merge(*other.tree);
+		}
+	};
+
+	template<typename GridT>
+	GridBase* straighten_pith(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing, bool rotate)
+	{
+		typename GridT::Ptr source = openvdb::gridPtrCast<GridT>(grid->m_grid);
+		typename GridT::Ptr target = openvdb::gridPtrCast<GridT>(source->copyGridWithNewTree());
+
+		openvdb::CoordBBox bbox = source->evalActiveVoxelBoundingBox();
+
+		if (!pith.empty() && z_spacing > 0.0 && !bbox.empty())
+		{
+			PithFrames frames(pith, z_origin, z_spacing, rotate);
+
+			// Index z slices between the first and last station
+			const openvdb::math::Transform& xform = source->transform();
+			double z0 = xform.worldToIndex(openvdb::Vec3d(0.0, 0.0, frames.stations.front())).z();
+			double z1 = xform.worldToIndex(openvdb::Vec3d(0.0, 0.0, frames.stations.back())).z();
+
+			int k_begin = (int)std::ceil(std::min(z0, z1));
+			int k_end = (int)std::floor(std::max(z0, z1)) + 1;
+
+			if (k_begin < k_end)
+			{
+				PithStraightener<GridT> straightener(*source, frames, bbox, k_begin, k_end);
+				tbb::parallel_reduce(slab_range(k_begin, k_end), straightener);
+
+				target->setTree(straightener.tree);
+			}
+		}
+
+		GridBase* new_grid = new GridBase();
+		new_grid->m_grid = target;
+
+		return new_grid;
+	}
+
+	template<typename GridT>
+	void polar_unwrap(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing,
+		int k_begin, int k_end, int num_radii, int num_angles, double radial_step, typename GridT::ValueType* values)
+	{
+		using ValueT = typename GridT::ValueType;
+
+		if (k_end <= k_begin || num_radii <= 0 || num_angles <= 0)
+			return;
+
+		typename GridT::Ptr source = openvdb::gridPtrCast<GridT>(grid->m_grid);
+		const openvdb::math::Transform& xform = source->transform();
+
+		PithFrames frames(pith, z_origin, z_spacing, false);
+
+		// Table of cos and sin per angle, taken to an index-space step of one radial_step. The
+		// transform is linear, so every sample is then a multiply-add from the pith of its slice.
+		std::vector<openvdb::Vec3d> steps(num_angles);
+		openvdb::Vec3d origin = xform.worldToIndex(openvdb::Vec3d(0.0));
+		for (int a = 0; a < num_angles; ++a)
+		{
+			double angle = 2.0 * openvdb::math::pi<double>() * a / num_angles;
+			steps[a] = (xform.worldToIndex(openvdb::Vec3d(std::cos(angle), std::sin(angle), 0.0)) - origin) * radial_step;
+		}
+
+		const size_t slice_size = (size_t)num_angles * num_radii;
+
+		tbb::parallel_for(tbb::blocked_range<int>(k_begin, k_end), [&](const tbb::blocked_range<int>& range)
+		{
+			typename GridT::ConstAccessor accessor = source->getConstAccessor();
+			openvdb::tools::GridSampler<typename GridT::ConstAccessor, openvdb::tools::BoxSampler> sampler(accessor, xform);
+
+			for (int k = range.begin(); k < range.end(); ++k)
+			{
+				ValueT* slice = values + (size_t)(k - k_begin) * slice_size;
+
+				openvdb::Vec3d centre, u, v;
+				if (!frames.frame(xform.indexToWorld(openvdb::Vec3d(0.0, 0.0, k)).z(), centre, u, v))
+				{
+					std::fill(slice, slice + slice_size, source->background());
+					continue;
+				}
+
+				openvdb::Vec3d c = xform.worldToIndex(centre);
+
+				for (int a = 0; a < num_angles; ++a)
+				{
+					ValueT* row = slice + (size_t)a * num_radii;
+					for (int r = 0; r < num_radii; ++r)
+						row[r] = (ValueT)sampler.isSample(c + steps[a] * r);
+				}
+			}
+		});
+	}
+
 	template<typename GridT>
 	void gradient(GridBase* grid)
 	{
@@ -171,6 +450,327 @@ namespace DeepSight
 		dgrid->m_grid = grid;
 		return dgrid;
 	}
+
+	// Index-space box of a knot capsule grown by reach, in world units, from the corners of its world box
+	static openvdb::CoordBBox knot_index_bbox(const RawLam::knot& k, const openvdb::math::Transform& xform, double reach)
+	{
+		const openvdb::Vec3d a(k.start.x(), k.start.y(), k.start.z()), b(k.end.x(), k.end.y(), k.end.z());
+
+		openvdb::Vec3d wmin = openvdb::math::minComponent(a, b) - openvdb::Vec3d(reach);
+		openvdb::Vec3d wmax = openvdb::math::maxComponent(a, b) + openvdb::Vec3d(reach);
+
+		openvdb::CoordBBox bbox;
+		for (int c = 0; c < 8; ++c)
+		{
+			openvdb::Vec3d corner((c & 1) ? wmax.x() : wmin.x(), (c & 2) ? wmax.y() : wmin.y(), (c & 4) ? wmax.z() : wmin.z());
+			openvdb::Vec3d ijk = xform.worldToIndex(corner);
+			bbox.expand(openvdb::Coord::floor(ijk));
+			bbox.expand(openvdb::Coord::ceil(ijk));
+		}
+
+		return bbox;
+	}
+
+	// Signed distance from the world position p to the surface of a knot capsule
+	static float knot_distance(const RawLam::knot& k, const openvdb::Vec3d& p)
+	{
+		const openvdb::Vec3d a(k.start.x(), k.start.y(), k.start.z()), b(k.end.x(), k.end.y(), k.end.z());
+		const openvdb::Vec3d ab = b - a;
+		const double len2 = ab.lengthSqr();
+
+		double t = len2 > 0.0 ? openvdb::math::Clamp((p - a).dot(ab) / len2, 0.0, 1.0) : 0.0;
+		return (float)((a + t * ab - p).length() - k.radius);
+	}
+
+	// Rasterizes a range of knots into trees of its own. Only voxels within the band of a
+	// surface are written, and every one keeps the smallest signed distance of the knots of
+	// the range and the knot it belongs to.
+	struct KnotRasterizer
+	{
+		const std::vector<RawLam::knot>& knots;
+		const openvdb::math::Transform& xform;
+		float band;
+
+		openvdb::FloatTree::Ptr distance;
+		openvdb::Int32Tree::Ptr index;
+
+		KnotRasterizer(const std::vector<RawLam::knot>& knots, const openvdb::math::Transform& xform, float band)
+			: knots(knots), xform(xform), band(band),
+			distance(new openvdb::FloatTree(band)), index(new openvdb::Int32Tree(-1))
+		{
+		}
+
+		KnotRasterizer(KnotRasterizer& other, tbb::split)
+			: KnotRasterizer(other.knots, other.xform, other.band)
+		{
+		}
+
+		void operator()(const tbb::blocked_range<size_t>& range)
+		{
+			openvdb::tree::ValueAccessor<openvdb::FloatTree> dacc(*distance);
+			openvdb::tree::ValueAccessor<openvdb::Int32Tree> iacc(*index);
+
+			for (size_t n = range.begin(); n < range.end(); ++n)
+			{
+				const RawLam::knot& k = knots[n];
+				openvdb::CoordBBox bbox = knot_index_bbox(k, xform, k.radius + band);
+
+				for (auto iter = bbox.begin(); iter; ++iter)
+				{
+					const openvdb::Coord& ijk = *iter;
+
+					float d = knot_distance(k, xform.indexToWorld(ijk));
+					if (std::abs(d) >= band)
+						continue;
+
+					if (!dacc.isValueOn(ijk) || d < dacc.getValue(ijk))
+					{
+						dacc.setValue(ijk, d);
+						iacc.setValue(ijk, (int)n);
+					}
+				}
+			}
+		}
+
+		void join(KnotRasterizer& other)
+		{
+			// Leaves that only other has are moved over whole. Voxels that both have are left to
+			// the pass over overlapping knots in volume_from_knots.
+			distance->merge(*other.distance);
+			index->merge(*other.index);
+		}
+	};
+
+	GridBase* volume_from_knots(
+		const std::vector<RawLam::knot>& knots,
+		const openvdb::math::Transform& xform,
+		float half_width, GridBase** index_grid)
+	{
+		// Band width in world units
+		float band = half_width * (float)xform.voxelSize()[0];
+
+		KnotRasterizer rasterizer(knots, xform, band);
+		tbb::parallel_reduce(tbb::blocked_range<size_t>(0, knots.size()), rasterizer);
+
+		// Interior voxels are not written, so a band voxel of one knot can lie deep inside another
+		// that was rasterized on another task. Leaves within the band of several knots take the
+		// nearest knot again, and voxels inside the band of none become interior.
+		RawLam::KnotIndex knot_index(knots);
+
+		std::vector<openvdb::FloatTree::LeafNodeType*> leaves;
+		rasterizer.distance->getNodes(leaves);
+
+		// The index tree was written alongside and has the same leaves. They are touched rather
+		// than probed so that the parallel pass never meets a missing one.
+		std::vector<openvdb::Int32Tree::LeafNodeType*> index_leaves(leaves.size());
+		for (size_t i = 0; i < leaves.size(); ++i)
+			index_leaves[i] = rasterizer.index->touchLeaf(leaves[i]->origin());
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, leaves.size()), [&](const tbb::blocked_range<size_t>& range)
+			{
+				std::vector<int> nearby;
+
+				for (size_t i = range.begin(); i < range.end(); ++i)
+				{
+					openvdb::FloatTree::LeafNodeType& leaf = *leaves[i];
+					openvdb::Int32Tree::LeafNodeType* index_leaf = index_leaves[i];
+
+					// World box of the voxels of the leaf, grown by the band
+					openvdb::BBoxd wbox;
+					for (int c = 0; c < 8; ++c)
+					{
+						const int dim = (int)openvdb::FloatTree::LeafNodeType::DIM - 1;
+						openvdb::Coord corner = leaf.origin() + openvdb::Coord((c & 1) ? dim : 0, (c & 2) ? dim : 0, (c & 4) ? dim : 0);
+						wbox.expand(xform.indexToWorld(corner));
+					}
+
+					nearby.clear();
+					knot_index.query_box(
+						Eigen::Vector3f((float)(wbox.min().x() - band), (float)(wbox.min().y() - band), (float)(wbox.min().z() - band)),
+						Eigen::Vector3f((float)(wbox.max().x() + band), (float)(wbox.max().y() + band), (float)(wbox.max().z() + band)),
+						nearby);
+
+					if (nearby.size() < 2)
+						continue;
+
+					for (auto iter = leaf.beginValueOn(); iter; ++iter)
+					{
+						openvdb::Vec3d p = xform.indexToWorld(iter.getCoord());
+
+						float d = std::numeric_limits<float>::max();
+						int nearest = -1;
+						for (int n : nearby)
+						{
+							float dn = knot_distance(knots[n], p);
+							if (dn < d)
+							{
+								d = dn;
+								nearest = n;
+							}
+						}
+
+						if (d <= -band)
+						{
+							iter.setValue(-band);
+							iter.setValueOff();
+							index_leaf->setValueOff(iter.pos(), -1);
+						}
+						else
+						{
+							iter.setValue(d);
+							index_leaf->setValueOnly(iter.pos(), nearest);
+						}
+					}
+				}
+			});
+
+		// Only the band was written, so the inside of the knots gets its sign from it
+		openvdb::tools::signedFloodFill(*rasterizer.distance);
+
+		auto grid = openvdb::FloatGrid::create(rasterizer.distance);
+		grid->setTransform(xform.copy());
+		grid->setGridClass(openvdb::GRID_LEVEL_SET);
+		grid->setName("knots");
+
+		if (index_grid)
+		{
+			auto igrid = openvdb::Int32Grid::create(rasterizer.index);
+			igrid->setTransform(xform.copy());
+			igrid->setName("knot_index");
+
+			*index_grid = new GridBase();
+			(*index_grid)->m_grid = igrid;
+		}
+
+		auto dgrid = new GridBase();
+		dgrid->m_grid = grid;
+		return dgrid;
+	}
+
+	// Fills outlines into slabs of 8 index z slices, so that every slab owns its leaves
+	struct OutlineRasterizer
+	{
+		const RawLam::InfoLog& infolog;
+		const openvdb::math::Transform& xform;
+		double z_origin, z_spacing;
+		int k_begin, k_end;
+
+		openvdb::Int32Tree::Ptr tree;
+
+		// Scratch space of a slice
+		std::vector<openvdb::Vec2d> polygon;
+		std::vector<double> crossings;
+
+		OutlineRasterizer(const RawLam::InfoLog& infolog, const openvdb::math::Transform& xform, double z_origin, double z_spacing, int k_begin, int k_end)
+			: infolog(infolog), xform(xform), z_origin(z_origin), z_spacing(z_spacing), k_begin(k_begin), k_end(k_end),
+			tree(new openvdb::Int32Tree(LABEL_OUTSIDE))
+		{
+		}
+
+		OutlineRasterizer(OutlineRasterizer& other, tbb::split)
+			: OutlineRasterizer(other.infolog, other.xform, other.z_origin, other.z_spacing, other.k_begin, other.k_end)
+		{
+		}
+
+		// Scanline fill of outline i of outlines, by the even-odd rule, at voxel centres
+		void fill(const RawLam::OutlineSet& outlines, size_t i, int k, double z, int label,
+			openvdb::tree::ValueAccessor<openvdb::Int32Tree>& accessor)
+		{
+			if (i >= outlines.size() || outlines.outline_size(i) < 3)
+				return;
+
+			const Eigen::Vector2f* points = outlines.outline(i);
+			polygon.resize(outlines.outline_size(i));
+
+			double ymin = std::numeric_limits<double>::max(), ymax = -ymin;
+			for (size_t j = 0; j < polygon.size(); ++j)
+			{
+				openvdb::Vec3d ijk = xform.worldToIndex(openvdb::Vec3d(points[j].x(), points[j].y(), z));
+				polygon[j] = openvdb::Vec2d(ijk.x(), ijk.y());
+
+				ymin = std::min(ymin, ijk.y());
+				ymax = std::max(ymax, ijk.y());
+			}
+
+			for (int y = (int)std::ceil(ymin); y <= (int)std::floor(ymax); ++y)
+			{
+				crossings.clear();
+
+				for (size_t j = 0, prev = polygon.size() - 1; j < polygon.size(); prev = j++)
+				{
+					const openvdb::Vec2d& p0 = polygon[prev];
+					const openvdb::Vec2d& p1 = polygon[j];
+
+					if ((p0.y() <= y) != (p1.y() <= y))
+						crossings.push_back(p0.x() + (y - p0.y()) * (p1.x() - p0.x()) / (p1.y() - p0.y()));
+				}
+
+				std::sort(crossings.begin(), crossings.end());
+
+				for (size_t c = 0; c + 1 < crossings.size(); c += 2)
+				{
+					for (int x = (int)std::ceil(crossings[c]); x <= (int)std::floor(crossings[c + 1]); ++x)
+						accessor.setValue(openvdb::Coord(x, y, k), label);
+				}
+			}
+		}
+
+		void operator()(const tbb::blocked_range<int>& slabs)
+		{
+			openvdb::tree::ValueAccessor<openvdb::Int32Tree> accessor(*tree);
+
+			for (int slab = slabs.begin(); slab < slabs.end(); ++slab)
+			{
+				int k0 = std::max(slab * 8, k_begin), k1 = std::min(slab * 8 + 8, k_end);
+
+				for (int k = k0; k < k1; ++k)
+				{
+					double z = xform.indexToWorld(openvdb::Vec3d(0.0, 0.0, k)).z();
+					long long i = std::llround((z - z_origin) / z_spacing);
+					if (i < 0 || i >= (long long)infolog.border.size())
+						continue;
+
+					fill(infolog.border, (size_t)i, k, z, LABEL_SAPWOOD, accessor);
+					fill(infolog.sapwood, (size_t)i, k, z, LABEL_HEARTWOOD, accessor);
+				}
+			}
+		}
+
+		void join(OutlineRasterizer& other)
+		{
+			tree->merge(*other.tree);
+		}
+	};
+
+	GridBase* outline_labels(
+		const RawLam::InfoLog& infolog,
+		const openvdb::math::Transform& xform,
+		double z_origin, double z_spacing)
+	{
+		auto grid = openvdb::Int32Grid::create(LABEL_OUTSIDE);
+		grid->setTransform(xform.copy());
+		grid->setName("labels");
+
+		if (!infolog.border.empty() && z_spacing != 0.0)
+		{
+			// Index z slices that lie within half a spacing of an outline
+			double z0 = xform.worldToIndex(openvdb::Vec3d(0.0, 0.0, z_origin - 0.5 * z_spacing)).z();
+			double z1 = xform.worldToIndex(openvdb::Vec3d(0.0, 0.0, z_origin + (infolog.border.size() - 0.5) * z_spacing)).z();
+
+			int k_begin = (int)std::ceil(std::min(z0, z1));
+			int k_end = (int)std::floor(std::max(z0, z1)) + 1;
+
+			OutlineRasterizer rasterizer(infolog, xform, z_origin, z_spacing, k_begin, k_end);
+			tbb::parallel_reduce(slab_range(k_begin, k_end), rasterizer);
+
+			grid->setTree(rasterizer.tree);
+		}
+
+		auto dgrid = new GridBase();
+		dgrid->m_grid = grid;
+		return dgrid;
+	}
+
 #pragma endregion Conversion_Tools
 #pragma region Template_specialization
 
@@ -178,6 +778,14 @@ namespace DeepSight
 	template GridBase* resample<openvdb::DoubleGrid>(GridBase* grid, float isovalue);
 	template GridBase* resample<openvdb::Int32Grid>(GridBase* grid, float isovalue);
 	
+	template GridBase* straighten_pith<openvdb::FloatGrid>(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing, bool rotate);
+	template GridBase* straighten_pith<openvdb::DoubleGrid>(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing, bool rotate);
+
+	template void polar_unwrap<openvdb::FloatGrid>(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing,
+		int k_begin, int k_end, int num_radii, int num_angles, double radial_step, float* values);
+	template void polar_unwrap<openvdb::DoubleGrid>(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing,
+		int k_begin, int k_end, int num_radii, int num_angles, double radial_step, double* values);
+
 	template void filter<openvdb::FloatGrid>(GridBase* grid, int width, int iterations, int type);
 	template void filter<openvdb::DoubleGrid>(GridBase* grid, int width, int iterations, int type);
 	template void filter<openvdb::Int32Grid>(GridBase* grid, int width, int iterations, int type);
@@ -196,6 +804,14 @@ namespace DeepSight
 	template void dilate<openvdb::Int32Grid>(GridBase* grid, int iterations);
 	template void dilate<openvdb::Vec3fGrid>(GridBase* grid, int iterations);
 
+	template void erode<UInt8Grid>(GridBase* grid, int iterations);
+	template void erode<UInt16Grid>(GridBase* grid, int iterations);
+	template void erode<HalfGrid>(GridBase* grid, int iterations);
+
+	template void dilate<UInt8Grid>(GridBase* grid, int iterations);
+	template void dilate<UInt16Grid>(GridBase* grid, int iterations);
+	template void dilate<HalfGrid>(GridBase* grid, int iterations);
+
 	template void volume_to_mesh<openvdb::FloatGrid>(
 		GridBase* grid, float isovalue,
 		std::vector<Eigen::Vector3f>& verts,
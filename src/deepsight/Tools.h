@@ -2,7 +2,11 @@
 #define TOOLS_H
 
 #include "GridBase.h"
+#include "QuantizedGrid.h"
 #include "ParticleList.h"
+#include "InfoLog.h"
+#include "KnotIndex.h"
+#include "Slabs.h"
 #include <openvdb/tools/ParticlesToLevelSet.h>
 #include <openvdb/tools/LevelSetUtil.h>
 
@@ -12,6 +16,12 @@
 #include <openvdb/tools/Dense.h>
 #include <openvdb/tree/ValueAccessor.h>
 #include <openvdb/tools/Morphology.h>
+#include <openvdb/tools/Prune.h>
+#include <openvdb/tools/SignedFloodFill.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_for.h>
 
 namespace DeepSight
 {
@@ -33,6 +43,31 @@ namespace DeepSight
 	template<typename GridT>
 	void dilate(GridBase* grid, int iterations);
 
+	// Filter and resample quantized grids through float, and encode the result with
+	// the quantization of the source grid. The whole grid is decoded into a temporary
+	// float grid first, so memory peaks at the float footprint while they run.
+	void filter_quantized(GridBase* grid, int width, int iterations, int type);
+	GridBase* resample_quantized(GridBase* grid, float scale);
+
+	// Resample a scalar grid along the pith of a log, so that the pith becomes the world z axis
+	// (x = y = 0). Pith point i lies at world z = z_origin + i * z_spacing, with z_spacing > 0,
+	// and its x and y are world coordinates. Without rotate, every index z slice is shifted by
+	// the pith position at its z. With rotate, slices are cut at right angles to the pith, with
+	// in-slice axes carried along it without twist, and the output z is z_origin plus the length
+	// along the pith. The result has the transform of the source grid, which is expected to keep
+	// the z axis, and holds trilinear samples wherever the nearest source voxel is active.
+	template<typename GridT>
+	GridBase* straighten_pith(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing, bool rotate);
+
+	// Sample index z slices [k_begin, k_end) of a scalar grid on polar rasters centred on the pith,
+	// with pith point i at world z = z_origin + i * z_spacing as for straighten_pith. values receives
+	// num_angles rows of num_radii samples per slice: value ((k - k_begin) * num_angles + a) * num_radii + r
+	// is taken at world radius r * radial_step and angle 2 pi a / num_angles from the x axis. Slices
+	// outside of the pith are filled with the background. The transform is expected to be linear.
+	template<typename GridT>
+	void polar_unwrap(GridBase* grid, const std::vector<Eigen::Vector2f>& pith, double z_origin, double z_spacing,
+		int k_begin, int k_end, int num_radii, int num_angles, double radial_step, typename GridT::ValueType* values);
+
 #pragma endregion Filter_Tools
 
 #pragma region Conversion_Tools
@@ -61,6 +96,35 @@ namespace DeepSight
 		int num_points, float* points, 
 		float radius, float voxelsize);
 
+	// Rasterize knots, taken as capsules of their radius around the segment from start to end,
+	// into a narrow-band level set with the transform xform. The band reaches half_width voxels
+	// to both sides of the surface; only voxels of the band are written, and the interior is
+	// filled in by sign. If index_grid is not null, it receives an Int32Grid holding, for the
+	// voxels of the band, the position in knots of the nearest one.
+	GridBase* volume_from_knots(
+		const std::vector<RawLam::knot>& knots,
+		const openvdb::math::Transform& xform,
+		float half_width, GridBase** index_grid = nullptr);
+
+	// Labels of the voxels of outline_labels
+	enum OutlineLabel
+	{
+		LABEL_OUTSIDE = 0,
+		LABEL_SAPWOOD = 1,
+		LABEL_HEARTWOOD = 2
+	};
+
+	// Fill the border and sapwood outlines of an InfoLog into an Int32Grid with the transform
+	// xform, slice by slice. Outline i lies at world z = z_origin + i * z_spacing, its points
+	// are world x and y, and every index z slice takes the nearest outline. Voxels inside the
+	// border are active with LABEL_SAPWOOD, those also inside the sapwood outline (the
+	// heartwood) with LABEL_HEARTWOOD, and everything else is inactive LABEL_OUTSIDE. The
+	// transform is expected to keep the z axis, i.e. without rotation.
+	GridBase* outline_labels(
+		const RawLam::InfoLog& infolog,
+		const openvdb::math::Transform& xform,
+		double z_origin, double z_spacing);
+
 #pragma endregion Conversion_Tools
 }
 
@@ -6,6 +6,36 @@ namespace DeepSight
 	GridBase* DoubleGrid_Resample(GridBase* ptr, float scale) { return resample<openvdb::DoubleGrid>(ptr, scale); }
 	GridBase* Int32Grid_Resample (GridBase* ptr, float scale) { return resample<openvdb::Int32Grid>(ptr, scale); }
 
+	GridBase* FloatGrid_StraightenPith(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing, int rotate)
+	{
+		if (!ptr || !infolog)
+			return nullptr;
+
+		return straighten_pith<openvdb::FloatGrid>(ptr, infolog->pith, z_origin, z_spacing, rotate != 0);
+	}
+
+	GridBase* DoubleGrid_StraightenPith(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing, int rotate)
+	{
+		if (!ptr || !infolog)
+			return nullptr;
+
+		return straighten_pith<openvdb::DoubleGrid>(ptr, infolog->pith, z_origin, z_spacing, rotate != 0);
+	}
+
+	void FloatGrid_PolarUnwrap(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing,
+		int k_begin, int k_end, int num_radii, int num_angles, double radial_step, float* values)
+	{
+		if (ptr && infolog && values)
+			polar_unwrap<openvdb::FloatGrid>(ptr, infolog->pith, z_origin, z_spacing, k_begin, k_end, num_radii, num_angles, radial_step, values);
+	}
+
+	void DoubleGrid_PolarUnwrap(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing,
+		int k_begin, int k_end, int num_radii, int num_angles, double radial_step, double* values)
+	{
+		if (ptr && infolog && values)
+			polar_unwrap<openvdb::DoubleGrid>(ptr, infolog->pith, z_origin, z_spacing, k_begin, k_end, num_radii, num_angles, radial_step, values);
+	}
+
 	void FloatGrid_Filter(GridBase* ptr, int width, int iterations, int type) { filter<openvdb::FloatGrid>(ptr, width, iterations, type); }
 	void DoubleGrid_Filter(GridBase* ptr, int width, int iterations, int type) { filter<openvdb::DoubleGrid>(ptr, width, iterations, type); }
 	void Int32Grid_Filter(GridBase* ptr, int width, int iterations, int type) { filter<openvdb::Int32Grid>(ptr, width, iterations, type); }
@@ -24,4 +54,19 @@ namespace DeepSight
 	void Int32Grid_Dilate(GridBase* ptr, int iterations) { dilate<openvdb::Int32Grid>(ptr, iterations); }
 	void Vec3fGrid_Dilate(GridBase* ptr, int iterations) { dilate<openvdb::Vec3fGrid>(ptr, iterations); } 
 
+	GridBase* UInt8Grid_Resample(GridBase* ptr, float scale) { return resample_quantized(ptr, scale); }
+	void UInt8Grid_Filter(GridBase* ptr, int width, int iterations, int type) { filter_quantized(ptr, width, iterations, type); }
+	void UInt8Grid_Erode(GridBase* ptr, int iterations) { erode<UInt8Grid>(ptr, iterations); }
+	void UInt8Grid_Dilate(GridBase* ptr, int iterations) { dilate<UInt8Grid>(ptr, iterations); }
+
+	GridBase* UInt16Grid_Resample(GridBase* ptr, float scale) { return resample_quantized(ptr, scale); }
+	void UInt16Grid_Filter(GridBase* ptr, int width, int iterations, int type) { filter_quantized(ptr, width, iterations, type); }
+	void UInt16Grid_Erode(GridBase* ptr, int iterations) { erode<UInt16Grid>(ptr, iterations); }
+	void UInt16Grid_Dilate(GridBase* ptr, int iterations) { dilate<UInt16Grid>(ptr, iterations); }
+
+	GridBase* HalfGrid_Resample(GridBase* ptr, float scale) { return resample_quantized(ptr, scale); }
+	void HalfGrid_Filter(GridBase* ptr, int width, int iterations, int type) { filter_quantized(ptr, width, iterations, type); }
+	void HalfGrid_Erode(GridBase* ptr, int iterations) { erode<HalfGrid>(ptr, iterations); }
+	void HalfGrid_Dilate(GridBase* ptr, int iterations) { dilate<HalfGrid>(ptr, iterations); }
+
 }
@@ -14,6 +14,18 @@ namespace DeepSight
 		DEEPSIGHT_EXPORT GridBase* DoubleGrid_Resample(GridBase* ptr, float scale);
 		DEEPSIGHT_EXPORT GridBase* Int32Grid_Resample(GridBase* ptr, float scale);
 
+		// Straighten a grid along the pith of infolog (see straighten_pith). Pith point i lies at world
+		// z = z_origin + i * z_spacing. With rotate, slices are cut at right angles to the pith.
+		DEEPSIGHT_EXPORT GridBase* FloatGrid_StraightenPith(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing, int rotate);
+		DEEPSIGHT_EXPORT GridBase* DoubleGrid_StraightenPith(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing, int rotate);
+
+		// Polar rasters of index z slices [k_begin, k_end) around the pith of infolog (see polar_unwrap).
+		// values must hold (k_end - k_begin) * num_angles * num_radii values.
+		DEEPSIGHT_EXPORT void FloatGrid_PolarUnwrap(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing,
+			int k_begin, int k_end, int num_radii, int num_angles, double radial_step, float* values);
+		DEEPSIGHT_EXPORT void DoubleGrid_PolarUnwrap(GridBase* ptr, RawLam::InfoLog* infolog, double z_origin, double z_spacing,
+			int k_begin, int k_end, int num_radii, int num_angles, double radial_step, double* values);
+
 		DEEPSIGHT_EXPORT void FloatGrid_Filter(GridBase* ptr, int width, int iterations, int type);
 		DEEPSIGHT_EXPORT void DoubleGrid_Filter(GridBase* ptr, int width, int iterations, int type);
 		DEEPSIGHT_EXPORT void Int32Grid_Filter(GridBase* ptr, int width, int iterations, int type);
@@ -32,6 +44,21 @@ namespace DeepSight
 		DEEPSIGHT_EXPORT void Int32Grid_Dilate(GridBase* ptr, int iterations);
 		DEEPSIGHT_EXPORT void Vec3fGrid_Dilate(GridBase* ptr, int iterations);
 
+		DEEPSIGHT_EXPORT GridBase* UInt8Grid_Resample(GridBase* ptr, float scale);
+		DEEPSIGHT_EXPORT void UInt8Grid_Filter(GridBase* ptr, int width, int iterations, int type);
+		DEEPSIGHT_EXPORT void UInt8Grid_Erode(GridBase* ptr, int iterations);
+		DEEPSIGHT_EXPORT void UInt8Grid_Dilate(GridBase* ptr, int iterations);
+
+		DEEPSIGHT_EXPORT GridBase* UInt16Grid_Resample(GridBase* ptr, float scale);
+		DEEPSIGHT_EXPORT void UInt16Grid_Filter(GridBase* ptr, int width, int iterations, int type);
+		DEEPSIGHT_EXPORT void UInt16Grid_Erode(GridBase* ptr, int iterations);
+		DEEPSIGHT_EXPORT void UInt16Grid_Dilate(GridBase* ptr, int iterations);
+
+		DEEPSIGHT_EXPORT GridBase* HalfGrid_Resample(GridBase* ptr, float scale);
+		DEEPSIGHT_EXPORT void HalfGrid_Filter(GridBase* ptr, int width, int iterations, int type);
+		DEEPSIGHT_EXPORT void HalfGrid_Erode(GridBase* ptr, int iterations);
+		DEEPSIGHT_EXPORT void HalfGrid_Dilate(GridBase* ptr, int iterations);
+
 #ifdef __cplusplus
 	}
 #endif